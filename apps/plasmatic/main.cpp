@@ -1,4 +1,5 @@
 #include "LinearAlgebra/LinearAlgebra.h"
+#include "Mesh/Partition.h"
 #include "ProblemTypes/ProblemTypes.h"
 
 #include <cxxopts.hpp>
@@ -7,18 +8,172 @@
 #include <fstream>
 
 namespace plasmatic {
+static auto ParseNodeOrdering(const nlohmann::json &input) -> NodeOrdering {
+    auto node_ordering = input.value("node_ordering", std::string("none"));
+    if (node_ordering == "none") {
+        return NodeOrdering::Original;
+    }
+    if (node_ordering == "rcm") {
+        return NodeOrdering::ReverseCuthillMcKee;
+    }
+    if (node_ordering == "hilbert") {
+        return NodeOrdering::Hilbert;
+    }
+
+    Abort("Unknown node ordering: {}", node_ordering);
+}
+
+static auto ParseKrylovMethod(const std::string &method) -> KrylovMethod {
+    if (method == "cg") {
+        return KrylovMethod::CG;
+    }
+    if (method == "gmres") {
+        return KrylovMethod::GMRES;
+    }
+    if (method == "bicgstab") {
+        return KrylovMethod::BiCGStab;
+    }
+    if (method == "preonly") {
+        return KrylovMethod::PreOnly;
+    }
+
+    Abort("Unknown Krylov method: {}", method);
+}
+
+static auto ParsePreconditioner(const std::string &preconditioner) -> Preconditioner {
+    if (preconditioner == "none") {
+        return Preconditioner::None;
+    }
+    if (preconditioner == "jacobi") {
+        return Preconditioner::Jacobi;
+    }
+    if (preconditioner == "ilu") {
+        return Preconditioner::ILU;
+    }
+    if (preconditioner == "gamg") {
+        return Preconditioner::GAMG;
+    }
+    if (preconditioner == "lu") {
+        return Preconditioner::LU;
+    }
+    if (preconditioner == "cholesky") {
+        return Preconditioner::Cholesky;
+    }
+
+    Abort("Unknown preconditioner: {}", preconditioner);
+}
+
+static auto ParseSolverOptions(const nlohmann::json &input) -> SolverOptions {
+    auto options = SymmetricSolverOptions();
+    if (!input.contains("solver")) {
+        return options;
+    }
+
+    const auto &solver = input["solver"];
+    if (solver.contains("method")) {
+        options.method = ParseKrylovMethod(solver["method"].get<std::string>());
+    }
+    if (solver.contains("preconditioner")) {
+        options.preconditioner = ParsePreconditioner(solver["preconditioner"].get<std::string>());
+    }
+
+    options.relative_tolerance = solver.value("relative_tolerance", options.relative_tolerance);
+    options.absolute_tolerance = solver.value("absolute_tolerance", options.absolute_tolerance);
+    options.max_iterations = solver.value("max_iterations", options.max_iterations);
+
+    return options;
+}
+
+static auto ParseTransientOptions(const nlohmann::json &input) -> TransientOptions {
+    TransientOptions options;
+    if (!input.contains("transient")) {
+        return options;
+    }
+
+    const auto &transient = input["transient"];
+    auto method = transient.value("method", std::string("backward_euler"));
+    if (method == "backward_euler") {
+        options.method = TimeIntegration::BackwardEuler;
+    } else if (method == "crank_nicolson") {
+        options.method = TimeIntegration::CrankNicolson;
+    } else {
+        Abort("Unknown time integration method: {}", method);
+    }
+
+    options.heat_capacity = transient.value("heat_capacity", options.heat_capacity);
+    options.initial_temperature = transient.value("initial_temperature", options.initial_temperature);
+    options.time_step = transient["time_step"].get<Float>();
+    options.num_time_steps = transient["num_time_steps"].get<Integer>();
+    options.output_interval = transient.value("output_interval", options.output_interval);
+    options.output_filename = input["output_file"].get<std::string>() + ".vtk";
+
+    return options;
+}
+
+static auto ParseTractionBCs(const nlohmann::json &traction_bcs)
+    -> std::unordered_map<std::string, std::array<Float, 3>> {
+    std::unordered_map<std::string, std::array<Float, 3>> result;
+    for (const auto &item : traction_bcs.items()) {
+        std::array<Float, 3> values = {};
+        auto values_vec = item.value()["value"].get<std::vector<Float>>();
+        for (size_t ii = 0; ii < values.size(); ++ii) {
+            values[ii] = values_vec[ii];
+        }
+
+        result.insert({item.value()["surface_name"].get<std::string>(), values});
+    }
+
+    return result;
+}
+
 static auto Run(const nlohmann::json &input) -> int {
     auto command = input["command"].get<std::string>();
 
     if (command == "surface_mesh") {
         auto mesh_filepath = input["mesh_filepath"].get<std::string>();
-        Mesh mesh(mesh_filepath);
-        mesh.WriteSurfaceMesh("surface_mesh");
+        Mesh mesh(mesh_filepath, input.value("threads", 1), input.value("mesh_cache", false));
+        if (CommRank() == 0) {
+            mesh.WriteSurfaceMesh("surface_mesh");
+        }
+    } else if (command == "partition_mesh") {
+        Mesh mesh(input["mesh_filepath"].get<std::string>(), input.value("threads", 1),
+                  input.value("mesh_cache", false));
+
+        // Partition the highest dimension elements unless told otherwise:
+        Integer dimension = 3;
+        while (dimension > 1 && mesh.GetNumElements(dimension) == 0) {
+            --dimension;
+        }
+        dimension = input.value("dimension", dimension);
+
+        auto partitioner = input.value("partitioner", std::string("rcb"));
+        Check(partitioner == "rcb" || partitioner == "parmetis", "Unknown partitioner: {}", partitioner);
+
+        auto partition =
+            PartitionMesh(mesh, dimension, input["num_parts"].get<Integer>(),
+                          partitioner == "rcb" ? PartitionMethod::RecursiveBisection : PartitionMethod::ParMETIS);
+
+        auto stats = ComputePartitionStats(mesh, partition);
+        for (size_t ii = 0; ii < stats.part_sizes.size(); ++ii) {
+            Log::Info("Part {}: {} elements", ii, stats.part_sizes[ii]);
+        }
+        Log::Info("Imbalance = {}, edge cut = {}, interface nodes = {}", stats.imbalance, stats.edge_cut,
+                  stats.interface_nodes);
+
+        if (CommRank() == 0) {
+            WritePartitionVTK(mesh, partition, input.value("output_file", std::string("partition")));
+        }
     } else if (command == "run_thermal_sim") {
         HeatEq2D::Input thermal_input = {.mesh_filename = input["mesh_filepath"].get<std::string>(),
                                          .thermal_conductivity = input["thermal_conductivity"].get<Float>(),
                                          .dirichlet_bcs = {},
-                                         .neumann_bcs = {}};
+                                         .neumann_bcs = {},
+                                         .num_threads = input.value("threads", 1),
+                                         .mesh_cache = input.value("mesh_cache", false),
+                                         .node_ordering = ParseNodeOrdering(input),
+                                         .matrix_free = input.value("matrix_free", false),
+                                         .solver = ParseSolverOptions(input),
+                                         .transient = ParseTransientOptions(input)};
 
         for (const auto &item : input["dirichlet_bcs"].items()) {
             thermal_input.dirichlet_bcs.insert(
@@ -40,7 +195,27 @@ static auto Run(const nlohmann::json &input) -> int {
                                               .youngs_modulus = input["youngs_modulus"].get<Float>(),
                                               .poisson_ratio = input["poisson_ratio"].get<Float>(),
                                               .dirichlet_bcs = {},
-                                              .neumann_bcs = {}};
+                                              .neumann_bcs = {},
+                                              .matrix_format = MatrixFormat::BlockAIJ,
+                                              .num_threads = input.value("threads", 1),
+                                              .mesh_cache = input.value("mesh_cache", false),
+                                              .node_ordering = ParseNodeOrdering(input),
+                                              .matrix_free = input.value("matrix_free", false),
+                                              .solver = ParseSolverOptions(input),
+                                              .load_cases = {}};
+
+        if (input.contains("matrix_format")) {
+            auto matrix_format = input["matrix_format"].get<std::string>();
+            if (matrix_format == "aij") {
+                mechanical_input.matrix_format = MatrixFormat::AIJ;
+            } else if (matrix_format == "baij") {
+                mechanical_input.matrix_format = MatrixFormat::BlockAIJ;
+            } else if (matrix_format == "sbaij") {
+                mechanical_input.matrix_format = MatrixFormat::SymmetricBlockAIJ;
+            } else {
+                Abort("Unknown matrix format: {}", matrix_format);
+            }
+        }
 
         for (const auto &item : input["displacement_bcs"].items()) {
             std::array<Float, 3> values = {};
@@ -52,14 +227,12 @@ static auto Run(const nlohmann::json &input) -> int {
             mechanical_input.dirichlet_bcs.insert({item.value()["surface_name"].get<std::string>(), values});
         }
 
-        for (const auto &item : input["traction_bcs"].items()) {
-            std::array<Float, 3> values = {};
-            auto values_vec = item.value()["value"].get<std::vector<Float>>();
-            for (size_t ii = 0; ii < values.size(); ++ii) {
-                values[ii] = values_vec[ii];
-            }
+        mechanical_input.neumann_bcs = ParseTractionBCs(input.value("traction_bcs", nlohmann::json::array()));
 
-            mechanical_input.neumann_bcs.insert({item.value()["surface_name"].get<std::string>(), values});
+        for (const auto &item : input.value("load_cases", nlohmann::json::array()).items()) {
+            mechanical_input.load_cases.push_back(
+                {.name = item.value()["name"].get<std::string>(),
+                 .neumann_bcs = ParseTractionBCs(item.value().value("traction_bcs", nlohmann::json::array()))});
         }
 
         Mechanical problem(mechanical_input);
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Utility/Utility.h"
+
+#include <span>
+#include <vector>
+
+namespace plasmatic {
+
+// Converts a list of dofs into block indices when it is made of whole blocks of `block_size` consecutive dofs that start
+// on a block boundary (e.g. the x, y, z dofs of every node). Returns false if the dofs can't be inserted blockwise.
+inline bool ToBlockIndices(std::span<const Integer> dofs, Integer block_size, std::vector<Integer> &block_indices) {
+    const auto stride = static_cast<size_t>(block_size);
+
+    if (block_size <= 1 || dofs.size() % stride != 0) {
+        return false;
+    }
+
+    block_indices.resize(dofs.size() / stride);
+    for (size_t ii = 0; ii < block_indices.size(); ++ii) {
+        const auto first = dofs[ii * stride];
+        if (first % block_size != 0) {
+            return false;
+        }
+
+        for (size_t jj = 1; jj < stride; ++jj) {
+            if (dofs[ii * stride + jj] != first + static_cast<Integer>(jj)) {
+                return false;
+            }
+        }
+
+        block_indices[ii] = first / block_size;
+    }
+
+    return true;
+}
+
+} // namespace plasmatic
@@ -0,0 +1,23 @@
+#include "interface/LinearAlgebra/Communicator.h"
+
+#include <petscsys.h>
+
+namespace plasmatic {
+
+Integer CommRank() {
+    PetscMPIInt rank = 0;
+    const PetscErrorCode ierr = MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    Check(ierr == 0, "MPI returned a non-zero error code: {}", ierr);
+
+    return rank;
+}
+
+Integer CommSize() {
+    PetscMPIInt size = 0;
+    const PetscErrorCode ierr = MPI_Comm_size(PETSC_COMM_WORLD, &size);
+    Check(ierr == 0, "MPI returned a non-zero error code: {}", ierr);
+
+    return size;
+}
+
+} // namespace plasmatic
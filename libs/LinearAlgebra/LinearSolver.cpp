@@ -0,0 +1,143 @@
+#include "interface/LinearAlgebra/LinearSolver.h"
+
+#include <chrono>
+
+namespace plasmatic {
+
+namespace {
+
+const char *KSPTypeName(KrylovMethod method) {
+    switch (method) {
+    case KrylovMethod::CG:
+        return KSPCG;
+    case KrylovMethod::GMRES:
+        return KSPGMRES;
+    case KrylovMethod::BiCGStab:
+        return KSPBCGS;
+    case KrylovMethod::PreOnly:
+        return KSPPREONLY;
+    }
+
+    Abort("Unknown Krylov method: {}", static_cast<int>(method));
+}
+
+const char *PCTypeName(Preconditioner preconditioner) {
+    switch (preconditioner) {
+    case Preconditioner::None:
+        return PCNONE;
+    case Preconditioner::Jacobi:
+        return PCJACOBI;
+    case Preconditioner::ILU:
+        return PCILU;
+    case Preconditioner::GAMG:
+        return PCGAMG;
+    case Preconditioner::LU:
+        return PCLU;
+    case Preconditioner::Cholesky:
+        return PCCHOLESKY;
+    }
+
+    Abort("Unknown preconditioner: {}", static_cast<int>(preconditioner));
+}
+
+// Logs the iterations of the last solve, and warns if it failed. Returns the iterations:
+Integer LogConvergence(KSP ksp) {
+    PetscInt iterations = 0;
+    PetscErrorCode ierr = KSPGetIterationNumber(ksp, &iterations);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    KSPConvergedReason reason = KSP_CONVERGED_ITERATING;
+    ierr = KSPGetConvergedReason(ksp, &reason);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    if (reason < 0) {
+        Log::Warn("Linear solve diverged after {} iterations (KSPConvergedReason {})", iterations,
+                  static_cast<Integer>(reason));
+    } else {
+        Log::Info("Linear solve converged in {} iterations", iterations);
+    }
+
+    return iterations;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+LinearSolver::LinearSolver(Matrix &matrix, const SolverOptions &options) : _matrix(matrix) {
+    PetscErrorCode ierr = KSPCreate(PETSC_COMM_WORLD, &_ksp);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = KSPSetType(_ksp, KSPTypeName(options.method));
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    // Matrix-free matrices can't be factored or coarsened, but they have a diagonal:
+    auto preconditioner_type = options.preconditioner;
+    if (matrix._matrixFree && preconditioner_type != Preconditioner::None &&
+        preconditioner_type != Preconditioner::Jacobi) {
+        Log::Info("Matrix-free matrices only support Jacobi preconditioning, using it instead of {}",
+                  PCTypeName(preconditioner_type));
+        preconditioner_type = Preconditioner::Jacobi;
+    }
+
+    PC preconditioner = nullptr;
+    ierr = KSPGetPC(_ksp, &preconditioner);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+    ierr = PCSetType(preconditioner, PCTypeName(preconditioner_type));
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+    ierr = KSPSetTolerances(_ksp, options.relative_tolerance, options.absolute_tolerance, PETSC_DEFAULT,
+                            options.max_iterations);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = KSPSetFromOptions(_ksp);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+LinearSolver::~LinearSolver() {
+    const PetscErrorCode ierr = KSPDestroy(&_ksp);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+void LinearSolver::SetUp() {
+    if (_matrixVersion == _matrix.Version()) {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // Otherwise every solve would check whether the matrix changed, and only the version says that reliably:
+    PetscErrorCode ierr = KSPSetReusePreconditioner(_ksp, PETSC_FALSE);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = KSPSetOperators(_ksp, _matrix._data, _matrix._data);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = KSPSetUp(_ksp);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = KSPSetReusePreconditioner(_ksp, PETSC_TRUE);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    _matrixVersion = _matrix.Version();
+    ++_numSetups;
+
+    const std::chrono::duration<Float> elapsed = std::chrono::steady_clock::now() - start;
+    Log::Debug("Set up the preconditioner in {:.3f} s", elapsed.count());
+}
+
+Vector LinearSolver::Solve(const Vector &rhs) {
+    auto result = Vector::WithLayoutOf(rhs);
+    Solve(rhs, result);
+
+    return result;
+}
+
+void LinearSolver::Solve(const Vector &rhs, Vector &result) {
+    SetUp();
+
+    const PetscErrorCode ierr = KSPSolve(_ksp, rhs._data, result._data);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    _iterations = LogConvergence(_ksp);
+}
+
+} // namespace plasmatic
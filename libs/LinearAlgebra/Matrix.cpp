@@ -1,9 +1,143 @@
 #include "interface/LinearAlgebra/Matrix.h"
+#include "interface/LinearAlgebra/LinearSolver.h"
 
-#include <petscksp.h>
+#include "BlockIndices.h"
+
+#include <algorithm>
+#include <optional>
 
 namespace plasmatic {
 
+struct MatrixFreeContext {
+    MatrixFreeContext() = default;
+
+    MatrixFreeContext(const MatrixFreeContext &other) = delete;
+
+    MatrixFreeContext &operator=(const MatrixFreeContext &other) = delete;
+
+    ~MatrixFreeContext() {
+        PetscErrorCode ierr = VecScatterDestroy(&scatter);
+        Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+        for (auto *vec : {&masked_x, &local_x, &local_y}) {
+            ierr = VecDestroy(vec);
+            Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+        }
+    }
+
+    MatrixFreeMult mult;
+    MatrixFreeDiagonal diagonal;
+
+    // The input of a product with the constrained rows zeroed, and the owned followed by the ghost entries of the input
+    // and the output:
+    Vec masked_x = nullptr;
+    Vec local_x = nullptr;
+    Vec local_y = nullptr;
+    VecScatter scatter = nullptr;
+
+    // Owned rows with a Dirichlet condition (counted from the first owned row), sorted:
+    std::vector<Integer> constrained_rows;
+};
+
+namespace {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+size_t num_duplicates = 0;
+
+MatType ToPetscType(MatrixFormat format) {
+    switch (format) {
+    case MatrixFormat::AIJ:
+        return MATAIJ;
+    case MatrixFormat::BlockAIJ:
+        return MATBAIJ;
+    case MatrixFormat::SymmetricBlockAIJ:
+        return MATSBAIJ;
+    }
+
+    Abort("Unknown matrix format: {}", static_cast<int>(format));
+}
+
+// Sets the given owned entries (counted from the first owned one) of `to` to the value in `from`, or to `value` if
+// `from` is null:
+void SetOwnedEntries(Vec to, std::span<const Integer> local_rows, Vec from, Float value) {
+    std::optional<ConstVectorView> from_values;
+    if (from != nullptr) {
+        from_values.emplace(from);
+    }
+
+    const VectorView to_values(to);
+    for (const auto &row : local_rows) {
+        to_values[row] = from_values ? (*from_values)[row] : value;
+    }
+}
+
+// Calls fn with the local (owned and ghost) entries of x (unless x is null) and y, with y zeroed first:
+template <typename Function> void WithLocalEntries(Vec x, Vec y, Function &&fn) {
+    const PetscErrorCode ierr = VecSet(y, 0.0);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    std::optional<ConstVectorView> x_values;
+    if (x != nullptr) {
+        x_values.emplace(x);
+    }
+
+    const VectorView y_values(y);
+    fn(x_values ? x_values->Values() : std::span<const Float>(), y_values.Values());
+}
+
+// Sums the local entries of y of all ranks into the distributed vector:
+void AddLocalEntries(const MatrixFreeContext &context, Vec result) {
+    PetscErrorCode ierr = VecSet(result, 0.0);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecScatterBegin(context.scatter, context.local_y, result, ADD_VALUES, SCATTER_REVERSE);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecScatterEnd(context.scatter, context.local_y, result, ADD_VALUES, SCATTER_REVERSE);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+// MATOP_MULT of matrix-free matrices. The rows and columns with Dirichlet conditions are those of the identity:
+PetscErrorCode MatrixFreeMultiply(Mat matrix, Vec x, Vec y) {
+    MatrixFreeContext *context = nullptr;
+    PetscErrorCode ierr = MatShellGetContext(matrix, &context);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecCopy(x, context->masked_x);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+    SetOwnedEntries(context->masked_x, context->constrained_rows, nullptr, 0.0);
+
+    ierr = VecScatterBegin(context->scatter, context->masked_x, context->local_x, INSERT_VALUES, SCATTER_FORWARD);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecScatterEnd(context->scatter, context->masked_x, context->local_x, INSERT_VALUES, SCATTER_FORWARD);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    WithLocalEntries(context->local_x, context->local_y, context->mult);
+    AddLocalEntries(*context, y);
+
+    SetOwnedEntries(y, context->constrained_rows, x, 0.0);
+
+    return 0;
+}
+
+// MATOP_GET_DIAGONAL of matrix-free matrices (for Jacobi preconditioning):
+PetscErrorCode MatrixFreeGetDiagonal(Mat matrix, Vec diagonal) {
+    MatrixFreeContext *context = nullptr;
+    const PetscErrorCode ierr = MatShellGetContext(matrix, &context);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    WithLocalEntries(nullptr, context->local_y,
+                     [context](std::span<const Float> /*x*/, std::span<Float> y) { context->diagonal(y); });
+    AddLocalEntries(*context, diagonal);
+
+    SetOwnedEntries(diagonal, context->constrained_rows, nullptr, 1.0);
+
+    return 0;
+}
+
+} // namespace
+
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
 Matrix::Matrix(Integer global_rows, Integer global_cols) {
     PetscErrorCode ierr = MatCreate(PETSC_COMM_WORLD, &_data);
@@ -18,12 +152,134 @@ Matrix::Matrix(Integer global_rows, Integer global_cols) {
 
     ierr = MatSetUp(_data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    SetColumnOriented();
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+Matrix::Matrix(const SparsityPattern &pattern, MatrixFormat format) {
+    PetscErrorCode ierr = MatCreate(PETSC_COMM_WORLD, &_data);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = MatSetSizes(_data, pattern.LocalRows(), pattern.LocalRows(), pattern.GlobalRows(), pattern.GlobalRows());
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = MatSetBlockSize(_data, pattern.BlockSize());
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = MatSetType(_data, ToPetscType(format));
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = MatSetFromOptions(_data);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = MatXAIJSetPreallocation(_data, pattern.BlockSize(), pattern.DiagonalNonzeros().data(),
+                                   pattern.OffDiagonalNonzeros().data(), pattern.UpperDiagonalNonzeros().data(),
+                                   pattern.UpperOffDiagonalNonzeros().data());
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    // Element matrices are full, so let symmetric storage drop the lower triangle instead of erroring on it:
+    if (format == MatrixFormat::SymmetricBlockAIJ) {
+        ierr = MatSetOption(_data, MAT_IGNORE_LOWER_TRIANGULAR, PETSC_TRUE);
+        Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+    }
+
+    // The pattern is exact, so any insertion outside of it is a bug rather than something to silently malloc for:
+    ierr = MatSetOption(_data, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    SetColumnOriented();
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+Matrix::Matrix(const SparsityPattern &pattern, std::span<const Integer> ghost_rows, MatrixFreeMult mult,
+               MatrixFreeDiagonal diagonal)
+    : _matrixFree(std::make_unique<MatrixFreeContext>()) {
+    _matrixFree->mult = std::move(mult);
+    _matrixFree->diagonal = std::move(diagonal);
+
+    PetscErrorCode ierr = MatCreateShell(PETSC_COMM_WORLD, pattern.LocalRows(), pattern.LocalRows(),
+                                         pattern.GlobalRows(), pattern.GlobalRows(), _matrixFree.get(), &_data);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = MatSetBlockSize(_data, pattern.BlockSize());
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    ierr = MatShellSetOperation(_data, MATOP_MULT, reinterpret_cast<void (*)()>(&MatrixFreeMultiply));
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    ierr = MatShellSetOperation(_data, MATOP_GET_DIAGONAL, reinterpret_cast<void (*)()>(&MatrixFreeGetDiagonal));
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = MatSetOption(_data, MAT_SYMMETRIC, PETSC_TRUE);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    // The local entries of a product are the owned rows followed by the ghost rows, gathered from (and summed back
+    // into) the distributed vectors by one scatter:
+    ierr = MatCreateVecs(_data, &_matrixFree->masked_x, nullptr);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    const auto [row_start, row_end] = OwnershipRange();
+    std::vector<Integer> local_rows;
+    local_rows.reserve(static_cast<size_t>(row_end - row_start) + ghost_rows.size());
+    for (auto row = row_start; row < row_end; ++row) {
+        local_rows.push_back(row);
+    }
+    local_rows.insert(local_rows.end(), ghost_rows.begin(), ghost_rows.end());
+
+    const auto num_local_rows = static_cast<Integer>(local_rows.size());
+    ierr = VecCreateSeq(PETSC_COMM_SELF, num_local_rows, &_matrixFree->local_x);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecDuplicate(_matrixFree->local_x, &_matrixFree->local_y);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    IS index_set = nullptr;
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, num_local_rows, local_rows.data(), PETSC_COPY_VALUES, &index_set);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecScatterCreate(_matrixFree->masked_x, index_set, _matrixFree->local_x, nullptr, &_matrixFree->scatter);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = ISDestroy(&index_set);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
 Matrix::Matrix(const Matrix &other) {
+    Check(!other._matrixFree, "Matrix-free matrices can't be copied");
+
     const PetscErrorCode ierr = MatDuplicate(other._data, MAT_COPY_VALUES, &_data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+    ++num_duplicates;
+
+    SetColumnOriented();
+}
+
+Matrix::Matrix(Matrix &&other) noexcept
+    : _data(std::exchange(other._data, nullptr)), _matrixFree(std::move(other._matrixFree)),
+      _solveIterations(other._solveIterations), _version(other._version),
+      _blockIndices(std::move(other._blockIndices)) {}
+
+Matrix &Matrix::operator=(const Matrix &other) {
+    if (this != &other) {
+        *this = Matrix(other);
+    }
+
+    return *this;
+}
+
+Matrix &Matrix::operator=(Matrix &&other) noexcept {
+    // The version keeps increasing, so that solvers of this matrix still see that it changed:
+    std::swap(_data, other._data);
+    std::swap(_matrixFree, other._matrixFree);
+    std::swap(_blockIndices, other._blockIndices);
+    _solveIterations = other._solveIterations;
+    _version = std::max(_version, other._version) + 1;
+
+    return *this;
 }
 
 Matrix::~Matrix() {
@@ -31,6 +287,8 @@ Matrix::~Matrix() {
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 }
 
+size_t Matrix::NumDuplicates() { return num_duplicates; }
+
 Integer Matrix::Rows() const {
     Integer rows = 0;
     Integer cols = 0;
@@ -49,6 +307,30 @@ Integer Matrix::Cols() const {
     return cols;
 }
 
+std::pair<Integer, Integer> Matrix::OwnershipRange() const {
+    Integer start = 0;
+    Integer end = 0;
+    const PetscErrorCode ierr = MatGetOwnershipRange(_data, &start, &end);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    return {start, end};
+}
+
+MatrixInfo Matrix::GetInfo() const {
+    MatInfo info;
+    PetscErrorCode ierr = MatGetInfo(_data, MAT_GLOBAL_SUM, &info);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    Integer block_size = 1;
+    ierr = MatGetBlockSize(_data, &block_size);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    return {.nonzeros_allocated = info.nz_allocated,
+            .nonzeros_used = info.nz_used,
+            .mallocs = info.mallocs,
+            .block_size = block_size};
+}
+
 void Matrix::AddValue(Integer row, Integer col, Float value) {
     const PetscErrorCode ierr = MatSetValues(_data, 1, &row, 1, &col, &value, ADD_VALUES);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
@@ -59,7 +341,51 @@ void Matrix::SetValue(Integer row, Integer col, Float value) {
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 }
 
+void Matrix::AddElementMatrix(std::span<const Integer> dofs, const Eigen::Ref<const Eigen::MatrixXd> &values) {
+    Check(values.rows() == static_cast<Eigen::Index>(dofs.size()) && values.cols() == values.rows(),
+          "Element matrix of size {}x{} does not match the {} dofs", values.rows(), values.cols(), dofs.size());
+
+    // Eigen matrices are column major and may be a view into a larger matrix; PETSc needs a contiguous array:
+    Eigen::MatrixXd contiguous;
+    const Float *data = values.data();
+    if (values.outerStride() != values.rows()) {
+        contiguous = values;
+        data = contiguous.data();
+    }
+
+    Integer block_size = 1;
+    PetscErrorCode ierr = MatGetBlockSize(_data, &block_size);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    if (ToBlockIndices(dofs, block_size, _blockIndices)) {
+        const auto num_blocks = static_cast<Integer>(_blockIndices.size());
+        ierr = MatSetValuesBlocked(_data, num_blocks, _blockIndices.data(), num_blocks, _blockIndices.data(), data,
+                                   ADD_VALUES);
+        Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+        return;
+    }
+
+    const auto num_dofs = static_cast<Integer>(dofs.size());
+    ierr = MatSetValues(_data, num_dofs, dofs.data(), num_dofs, dofs.data(), data, ADD_VALUES);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+void Matrix::AddBlockRow(Integer block_row, std::span<const Integer> block_columns, std::span<const Float> values) {
+    Integer block_size = 1;
+    PetscErrorCode ierr = MatGetBlockSize(_data, &block_size);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    const auto num_blocks = static_cast<Integer>(block_columns.size());
+    Check(values.size() == static_cast<size_t>(block_size * block_size * num_blocks),
+          "Block row with {} blocks of size {} does not match the {} values", num_blocks, block_size, values.size());
+
+    ierr = MatSetValuesBlocked(_data, 1, &block_row, num_blocks, block_columns.data(), values.data(), ADD_VALUES);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
 void Matrix::Assemble() {
+    ++_version;
+
     PetscErrorCode ierr = MatAssemblyBegin(_data, MAT_FINAL_ASSEMBLY);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 
@@ -92,61 +418,141 @@ Matrix Matrix::operator-(const Matrix &other) {
 }
 
 Matrix &Matrix::operator+=(const Matrix &other) {
+    ++_version;
+
     const PetscErrorCode ierr = MatAXPY(this->_data, 1.0, other._data, SAME_NONZERO_PATTERN);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
     return *this;
 }
 
 Matrix &Matrix::operator-=(const Matrix &other) {
+    ++_version;
+
     const PetscErrorCode ierr = MatAXPY(this->_data, -1.0, other._data, SAME_NONZERO_PATTERN);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
     return *this;
 }
 
 Vector Matrix::operator*(const Vector &other) {
-    Vector result(other);
+    auto result = Vector::WithLayoutOf(other);
+    Multiply(other, result);
+
+    return result;
+}
 
+void Matrix::Multiply(const Vector &other, Vector &result) {
     const PetscErrorCode ierr = MatMult(this->_data, other._data, result._data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+Vector Matrix::Solve(const Vector &other, const SolverOptions &options) {
+    auto result = Vector::WithLayoutOf(other);
+    Solve(other, result, options);
+
     return result;
 }
 
-Vector Matrix::Solve(const Vector &other) {
-    KSP ksp = nullptr;
+void Matrix::Solve(const Vector &other, Vector &result, const SolverOptions &options) {
+    LinearSolver solver(*this, options);
+    solver.Solve(other, result);
+    _solveIterations = solver.Iterations();
+}
+
+void Matrix::SetRigidBodyModes(const Vector &coordinates) {
+    ++_version;
 
-    PetscErrorCode ierr = KSPCreate(PETSC_COMM_WORLD, &ksp);
+    MatNullSpace rigid_body_modes = nullptr;
+    PetscErrorCode ierr = MatNullSpaceCreateRigidBody(coordinates._data, &rigid_body_modes);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 
-    ierr = KSPSetType(ksp, KSPGMRES);
+    ierr = MatSetNearNullSpace(_data, rigid_body_modes);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 
-    ierr = KSPSetOperators(ksp, this->_data, this->_data);
+    // The matrix keeps its own reference:
+    ierr = MatNullSpaceDestroy(&rigid_body_modes);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+void Matrix::SetDirichletBC(Integer row_col, const Vector &x, const Vector &b) {
+    ++_version;
 
-    PC preconditioner = nullptr;
-    ierr = KSPGetPC(ksp, &preconditioner);
+    if (_matrixFree) {
+        SetDirichletBCs(std::span<const Integer>(&row_col, 1), x, b);
+        return;
+    }
+
+    const PetscErrorCode ierr = MatZeroRowsColumns(_data, 1, &row_col, 1.0, x._data, b._data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
-    ierr = PCSetType(preconditioner, PCCHOLESKY);
+}
+
+void Matrix::SetDirichletBCs(std::span<const Integer> rows, const Vector &x, const Vector &b) {
+    ++_version;
+
+    if (!_matrixFree) {
+        std::vector<Integer> unique_rows(rows.begin(), rows.end());
+        std::sort(unique_rows.begin(), unique_rows.end());
+        unique_rows.erase(std::unique(unique_rows.begin(), unique_rows.end()), unique_rows.end());
+
+        const PetscErrorCode ierr = MatZeroRowsColumns(_data, static_cast<Integer>(unique_rows.size()),
+                                                       unique_rows.data(), 1.0, x._data, b._data);
+        Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+        return;
+    }
+
+    // The owned rows that aren't constrained yet:
+    const auto [row_start, row_end] = OwnershipRange();
+    auto &constrained_rows = _matrixFree->constrained_rows;
+    std::vector<Integer> new_rows;
+    for (const auto &row : rows) {
+        if (row >= row_start && row < row_end &&
+            !std::binary_search(constrained_rows.begin(), constrained_rows.end(), row - row_start)) {
+            new_rows.push_back(row - row_start);
+        }
+    }
+
+    std::sort(new_rows.begin(), new_rows.end());
+    new_rows.erase(std::unique(new_rows.begin(), new_rows.end()), new_rows.end());
+
+    // Like MatZeroRowsColumns: subtract the columns of the new rows times their values from the right hand side, then
+    // make them rows of the identity with their values on the right hand side:
+    Vec boundary_values = nullptr;
+    PetscErrorCode ierr = VecDuplicate(x._data, &boundary_values);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
-    constexpr auto rel_tol = 1.0e-10;
-    ierr = KSPSetTolerances(ksp, rel_tol, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT);
+
+    ierr = VecSet(boundary_values, 0.0);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+    SetOwnedEntries(boundary_values, new_rows, x._data, 0.0);
 
-    ierr = KSPSetFromOptions(ksp);
+    Vec product = nullptr;
+    ierr = VecDuplicate(b._data, &product);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 
-    Vector result(other);
-    ierr = KSPSolve(ksp, other._data, result._data);
+    ierr = MatMult(_data, boundary_values, product);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 
-    ierr = KSPDestroy(&ksp);
+    ierr = VecAXPY(b._data, -1.0, product);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+    SetOwnedEntries(b._data, new_rows, x._data, 0.0);
 
-    return result;
+    const auto num_constrained = static_cast<std::ptrdiff_t>(constrained_rows.size());
+    constrained_rows.insert(constrained_rows.end(), new_rows.begin(), new_rows.end());
+    std::inplace_merge(constrained_rows.begin(), constrained_rows.begin() + num_constrained, constrained_rows.end());
+
+    // The shell matrix changed without PETSc seeing it, which preconditioners check before reusing their setup:
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    ierr = PetscObjectStateIncrease(reinterpret_cast<PetscObject>(_data));
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecDestroy(&product);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecDestroy(&boundary_values);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 }
 
-void Matrix::SetDirichletBC(Integer row_col, const Vector &x, const Vector &b) {
-    const PetscErrorCode ierr = MatZeroRowsColumns(_data, 1, &row_col, 1.0, x._data, b._data);
+void Matrix::SetColumnOriented() {
+    // Lets element matrices be passed to PETSc directly in Eigen's (column major) storage order:
+    const PetscErrorCode ierr = MatSetOption(_data, MAT_ROW_ORIENTED, PETSC_FALSE);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 }
 
@@ -0,0 +1,66 @@
+#include "interface/LinearAlgebra/SparsityPattern.h"
+
+#include <petscsys.h>
+
+#include <algorithm>
+
+namespace plasmatic {
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+SparsityPattern::SparsityPattern(Integer global_rows, Integer block_size)
+    : _globalRows(global_rows), _localRows(PETSC_DECIDE), _rowStart(0), _blockSize(block_size) {
+    Check(block_size > 0 && global_rows % block_size == 0, "Invalid block size {} for {} rows", block_size,
+          global_rows);
+
+    // Use the same split as PETSc does for PETSC_DECIDE so the pattern matches vectors created with the global size:
+    PetscErrorCode ierr = PetscSplitOwnershipBlock(PETSC_COMM_WORLD, _blockSize, &_localRows, &_globalRows);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    Integer row_end = 0;
+    ierr = MPI_Scan(&_localRows, &row_end, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD);
+    Check(ierr == 0, "MPI returned a non-zero error code: {}", ierr);
+    _rowStart = row_end - _localRows;
+
+    PetscMPIInt num_ranks = 1;
+    ierr = MPI_Comm_size(PETSC_COMM_WORLD, &num_ranks);
+    Check(ierr == 0, "MPI returned a non-zero error code: {}", ierr);
+
+    const Integer block_row_start = BlockRowStart();
+    _blockRowStarts.resize(static_cast<size_t>(num_ranks) + 1);
+    ierr = MPI_Allgather(&block_row_start, 1, MPIU_INT, _blockRowStarts.data(), 1, MPIU_INT, PETSC_COMM_WORLD);
+    Check(ierr == 0, "MPI returned a non-zero error code: {}", ierr);
+    _blockRowStarts.back() = _globalRows / _blockSize;
+
+    _diagonalNonzeros.resize(static_cast<size_t>(_localRows / _blockSize), 0);
+    _offDiagonalNonzeros.resize(static_cast<size_t>(_localRows / _blockSize), 0);
+    _upperDiagonalNonzeros.resize(static_cast<size_t>(_localRows / _blockSize), 0);
+    _upperOffDiagonalNonzeros.resize(static_cast<size_t>(_localRows / _blockSize), 0);
+}
+
+Integer SparsityPattern::BlockRowOwner(Integer block_row) const {
+    Check(block_row >= 0 && block_row < _blockRowStarts.back(), "Block row {} is out of range", block_row);
+
+    // Ranks without rows have the same start as the next one, so take the last rank that starts at or before the row:
+    const auto next = std::upper_bound(_blockRowStarts.begin(), _blockRowStarts.end(), block_row);
+    return static_cast<Integer>(next - _blockRowStarts.begin()) - 1;
+}
+
+void SparsityPattern::SetBlockRowNonzeros(Integer block_row, Integer diagonal, Integer off_diagonal) {
+    Check(OwnsBlockRow(block_row), "Block row {} is not owned by this rank", block_row);
+
+    const auto local_row = static_cast<size_t>(block_row - BlockRowStart());
+    _diagonalNonzeros[local_row] = diagonal;
+    _offDiagonalNonzeros[local_row] = off_diagonal;
+    _upperDiagonalNonzeros[local_row] = diagonal;
+    _upperOffDiagonalNonzeros[local_row] = off_diagonal;
+}
+
+void SparsityPattern::SetUpperBlockRowNonzeros(Integer block_row, Integer diagonal, Integer off_diagonal) {
+    Check(OwnsBlockRow(block_row), "Block row {} is not owned by this rank", block_row);
+
+    const auto local_row = static_cast<size_t>(block_row - BlockRowStart());
+    _upperDiagonalNonzeros[local_row] = diagonal;
+    _upperOffDiagonalNonzeros[local_row] = off_diagonal;
+}
+
+} // namespace plasmatic
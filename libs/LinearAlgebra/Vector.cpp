@@ -1,9 +1,46 @@
 #include "interface/LinearAlgebra/Vector.h"
 
+#include "BlockIndices.h"
+
 namespace plasmatic {
 
+namespace {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+size_t num_duplicates = 0;
+
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+ConstVectorView::ConstVectorView(Vec data) : _data(data) {
+    PetscErrorCode ierr = VecGetLocalSize(_data, &_size);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecGetArrayRead(_data, &_values);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+ConstVectorView::~ConstVectorView() {
+    const PetscErrorCode ierr = VecRestoreArrayRead(_data, &_values);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+VectorView::VectorView(Vec data) : _data(data) {
+    PetscErrorCode ierr = VecGetLocalSize(_data, &_size);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecGetArray(_data, &_values);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+VectorView::~VectorView() {
+    const PetscErrorCode ierr = VecRestoreArray(_data, &_values);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
-Vector::Vector(Integer global_size) {
+Vector::Vector(Integer global_size, Integer block_size) {
     PetscErrorCode ierr = VecCreate(PETSC_COMM_WORLD, &_data);
 
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
@@ -11,6 +48,9 @@ Vector::Vector(Integer global_size) {
     ierr = VecSetSizes(_data, PETSC_DECIDE, global_size);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 
+    ierr = VecSetBlockSize(_data, block_size);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
     ierr = VecSetFromOptions(_data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 
@@ -19,19 +59,71 @@ Vector::Vector(Integer global_size) {
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
-Vector::Vector(const Vector &other) {
-    PetscErrorCode ierr = VecDuplicate(other._data, &_data);
+Vector::Vector(const SparsityPattern &pattern) {
+    PetscErrorCode ierr = VecCreate(PETSC_COMM_WORLD, &_data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 
-    ierr = VecCopy(other._data, _data);
+    ierr = VecSetSizes(_data, pattern.LocalRows(), pattern.GlobalRows());
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecSetBlockSize(_data, pattern.BlockSize());
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecSetFromOptions(_data);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecSet(_data, 0.0);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 }
 
+Vector::Vector(const Vector &other) : Vector(Duplicate(other)) {
+    const PetscErrorCode ierr = VecCopy(other._data, _data);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
+Vector::Vector(Vector &&other) noexcept
+    : _data(std::exchange(other._data, nullptr)), _blockIndices(std::move(other._blockIndices)) {}
+
+Vector &Vector::operator=(const Vector &other) {
+    if (this != &other) {
+        *this = Vector(other);
+    }
+
+    return *this;
+}
+
+Vector &Vector::operator=(Vector &&other) noexcept {
+    std::swap(_data, other._data);
+    std::swap(_blockIndices, other._blockIndices);
+
+    return *this;
+}
+
 Vector::~Vector() {
     const PetscErrorCode ierr = VecDestroy(&_data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 }
 
+size_t Vector::NumDuplicates() { return num_duplicates; }
+
+Vector Vector::Duplicate(const Vector &other) {
+    Vector result;
+    const PetscErrorCode ierr = VecDuplicate(other._data, &result._data);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+    ++num_duplicates;
+
+    return result;
+}
+
+Vector Vector::WithLayoutOf(const Vector &other) {
+    Vector result = Duplicate(other);
+
+    const PetscErrorCode ierr = VecSet(result._data, 0.0);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    return result;
+}
+
 Integer Vector::Size() const {
     Integer size = 0;
     const PetscErrorCode ierr = VecGetSize(_data, &size);
@@ -40,6 +132,15 @@ Integer Vector::Size() const {
     return size;
 }
 
+std::pair<Integer, Integer> Vector::OwnershipRange() const {
+    Integer start = 0;
+    Integer end = 0;
+    const PetscErrorCode ierr = VecGetOwnershipRange(_data, &start, &end);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    return {start, end};
+}
+
 void Vector::AddValue(Integer pos, Float value) {
     const PetscErrorCode ierr = VecSetValues(_data, 1, &pos, &value, ADD_VALUES);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
@@ -50,6 +151,25 @@ void Vector::SetValue(Integer pos, Float value) {
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
 }
 
+void Vector::AddElementVector(std::span<const Integer> dofs, const Eigen::Ref<const Eigen::VectorXd> &values) {
+    Check(values.size() == static_cast<Eigen::Index>(dofs.size()), "Element vector of size {} does not match the {} dofs",
+          values.size(), dofs.size());
+
+    Integer block_size = 1;
+    PetscErrorCode ierr = VecGetBlockSize(_data, &block_size);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    if (ToBlockIndices(dofs, block_size, _blockIndices)) {
+        ierr = VecSetValuesBlocked(_data, static_cast<Integer>(_blockIndices.size()), _blockIndices.data(),
+                                   values.data(), ADD_VALUES);
+        Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+        return;
+    }
+
+    ierr = VecSetValues(_data, static_cast<Integer>(dofs.size()), dofs.data(), values.data(), ADD_VALUES);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+}
+
 void Vector::Assemble() {
     PetscErrorCode ierr = VecAssemblyBegin(_data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
@@ -66,8 +186,36 @@ Float Vector::GetValue(Integer pos) {
     return value;
 }
 
+std::vector<Float> Vector::GatherAll() const {
+    VecScatter scatter = nullptr;
+    Vec all = nullptr;
+    PetscErrorCode ierr = VecScatterCreateToAll(_data, &scatter, &all);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecScatterBegin(scatter, _data, all, INSERT_VALUES, SCATTER_FORWARD);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecScatterEnd(scatter, _data, all, INSERT_VALUES, SCATTER_FORWARD);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    std::vector<Float> values;
+    {
+        const ConstVectorView view(all);
+        values.assign(view.Values().begin(), view.Values().end());
+    }
+
+    ierr = VecScatterDestroy(&scatter);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    ierr = VecDestroy(&all);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+
+    return values;
+}
+
 Vector Vector::operator+(const Vector &other) {
-    Vector result(this->Size());
+    // Only the layout is taken from this vector, every entry of the result is written by VecAXPBYPCZ:
+    Vector result = WithLayoutOf(*this);
 
     const PetscErrorCode ierr = VecAXPBYPCZ(result._data, 1.0, 1.0, 0.0, _data, other._data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
@@ -75,7 +223,7 @@ Vector Vector::operator+(const Vector &other) {
 }
 
 Vector Vector::operator-(const Vector &other) {
-    Vector result(this->Size());
+    Vector result = WithLayoutOf(*this);
 
     const PetscErrorCode ierr = VecAXPBYPCZ(result._data, 1.0, -1.0, 0.0, _data, other._data);
     Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
@@ -94,4 +242,10 @@ Vector &Vector::operator-=(const Vector &other) {
     return *this;
 }
 
+Vector &Vector::operator*=(Float factor) {
+    const PetscErrorCode ierr = VecScale(this->_data, factor);
+    Check(ierr == 0, "PETSc returned a non-zero error code: {}", ierr);
+    return *this;
+}
+
 } // namespace plasmatic
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Utility/Utility.h"
+
+namespace plasmatic {
+
+// Rank of this process and the number of processes in PETSC_COMM_WORLD:
+Integer CommRank();
+
+Integer CommSize();
+
+} // namespace plasmatic
@@ -1,4 +1,8 @@
 #pragma once
 
+#include "Communicator.h"
+#include "LinearSolver.h"
 #include "Matrix.h"
+#include "SolverOptions.h"
+#include "SparsityPattern.h"
 #include "Vector.h"
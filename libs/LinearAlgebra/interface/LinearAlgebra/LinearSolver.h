@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Utility/Utility.h"
+
+#include "Matrix.h"
+#include "SolverOptions.h"
+#include "Vector.h"
+
+#include <petscksp.h>
+
+#include <optional>
+
+namespace plasmatic {
+
+// Solves systems with one matrix many times (several right hand sides, time steps), keeping the PETSc KSP and its
+// preconditioner (e.g. a factorization) between solves. The preconditioner is only set up again when the matrix has
+// changed since the last solve, i.e. after it was assembled or given Dirichlet conditions. The matrix must outlive the
+// solver.
+class LinearSolver {
+  public:
+    LinearSolver(Matrix &matrix, const SolverOptions &options = {});
+
+    LinearSolver(const LinearSolver &other) = delete;
+
+    LinearSolver &operator=(const LinearSolver &other) = delete;
+
+    ~LinearSolver();
+
+    Vector Solve(const Vector &rhs);
+
+    // The same into an existing vector laid out like rhs, so that solving many times allocates nothing:
+    void Solve(const Vector &rhs, Vector &result);
+
+    // Iterations of the last solve:
+    Integer Iterations() const { return _iterations; }
+
+    // How often the preconditioner was set up:
+    Integer NumSetups() const { return _numSetups; }
+
+  private:
+    void SetUp();
+
+    Matrix &_matrix;
+    KSP _ksp;
+
+    // Matrix::Version() when the preconditioner was last set up:
+    std::optional<size_t> _matrixVersion;
+
+    Integer _iterations = 0;
+    Integer _numSetups = 0;
+};
+
+} // namespace plasmatic
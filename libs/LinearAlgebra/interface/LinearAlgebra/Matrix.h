@@ -2,28 +2,86 @@
 
 #include "Utility/Utility.h"
 
+#include "SolverOptions.h"
+#include "SparsityPattern.h"
 #include "Vector.h"
 
+#include <Eigen/Dense>
 #include <petscmat.h>
 
+#include <functional>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
 namespace plasmatic {
 
+// Storage formats for preallocated matrices. The block formats store one column index per block of the pattern's block
+// size; the symmetric one additionally only stores the upper triangle (lower triangular insertions are ignored).
+enum class MatrixFormat { AIJ, BlockAIJ, SymmetricBlockAIJ };
+
+// y = A x for a matrix that is never assembled. Both spans hold the entries of the rows owned by this rank followed by
+// the ghost rows given to the matrix; y starts at zero and what is added to its ghost rows goes to their owners.
+using MatrixFreeMult = std::function<void(std::span<const Float> x, std::span<Float> y)>;
+
+// The diagonal of such a matrix, laid out and summed over the ranks like y above:
+using MatrixFreeDiagonal = std::function<void(std::span<Float> diagonal)>;
+
+struct MatrixFreeContext;
+
+struct MatrixInfo {
+    Float nonzeros_allocated;
+    Float nonzeros_used;
+    Float mallocs;
+    Integer block_size;
+};
+
 class Matrix {
   public:
     Matrix(Integer global_rows, Integer global_cols);
 
+    Matrix(const SparsityPattern &pattern, MatrixFormat format = MatrixFormat::AIJ);
+
+    // A PETSc shell matrix distributed like the pattern (whose nonzeros aren't used) that calls `mult` for every
+    // product. `ghost_rows` are the rows of other ranks that mult reads and adds to. Only products, Solve (with CG and
+    // Jacobi preconditioning) and the Dirichlet conditions are supported, and it can't be copied.
+    Matrix(const SparsityPattern &pattern, std::span<const Integer> ghost_rows, MatrixFreeMult mult,
+           MatrixFreeDiagonal diagonal);
+
     Matrix(const Matrix &other);
 
+    // Moves only hand over the PETSc matrix (a LinearSolver of the moved from matrix can't be used anymore):
+    Matrix(Matrix &&other) noexcept;
+
+    Matrix &operator=(const Matrix &other);
+
+    Matrix &operator=(Matrix &&other) noexcept;
+
     ~Matrix();
 
+    // How many matrices were created with MatDuplicate (copies, sums and differences) so far:
+    static size_t NumDuplicates();
+
     Integer Rows() const;
 
     Integer Cols() const;
 
+    // First and one past the last row stored on this rank:
+    std::pair<Integer, Integer> OwnershipRange() const;
+
+    MatrixInfo GetInfo() const;
+
     void AddValue(Integer row, Integer col, Float value);
 
     void SetValue(Integer row, Integer col, Float value);
 
+    void AddElementMatrix(std::span<const Integer> dofs, const Eigen::Ref<const Eigen::MatrixXd> &values);
+
+    // Adds a whole block row at once: `values` holds the block_size x (block_size * block_columns.size()) entries of
+    // the row in column major order.
+    void AddBlockRow(Integer block_row, std::span<const Integer> block_columns, std::span<const Float> values);
+
     void Assemble();
 
     Float GetValue(Integer row, Integer col);
@@ -38,12 +96,46 @@ class Matrix {
 
     Vector operator*(const Vector &other);
 
-    Vector Solve(const Vector &other);
+    // result = this * other without creating a vector; result must be laid out like the rows of the matrix:
+    void Multiply(const Vector &other, Vector &result);
+
+    // Sets up the preconditioner for every call; LinearSolver keeps it for solving with the same matrix again:
+    Vector Solve(const Vector &other, const SolverOptions &options = {});
+
+    void Solve(const Vector &other, Vector &result, const SolverOptions &options = {});
+
+    // Iterations of the last Solve:
+    Integer SolveIterations() const { return _solveIterations; }
+
+    // Changes whenever the values of the matrix may have changed (assembly, Dirichlet conditions, sums), so that
+    // solvers know when to set up their preconditioner again:
+    size_t Version() const { return _version; }
+
+    // Attaches the six rigid body modes (translations and rotations) of the given node coordinates as the near null
+    // space of an elasticity matrix, which algebraic multigrid (GAMG) builds its coarse spaces from. The coordinates
+    // have block size 3 and are distributed like the rows of the matrix.
+    void SetRigidBodyModes(const Vector &coordinates);
 
     void SetDirichletBC(Integer row_col, const Vector &x, const Vector &b);
 
+    // The same for many rows at once (duplicates are fine), which is a single pass over the matrix. A matrix-free
+    // matrix only constrains the rows that this rank owns, and applies itself to the boundary values once per call.
+    void SetDirichletBCs(std::span<const Integer> rows, const Vector &x, const Vector &b);
+
+    friend class LinearSolver;
+
   private:
-    Mat _data;
+    void SetColumnOriented();
+
+    Mat _data = nullptr;
+
+    // Only set for matrix-free matrices:
+    std::unique_ptr<MatrixFreeContext> _matrixFree;
+
+    Integer _solveIterations = 0;
+    size_t _version = 0;
+
+    std::vector<Integer> _blockIndices;
 };
 
 } // namespace plasmatic
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Utility/Utility.h"
+
+namespace plasmatic {
+
+// PreOnly applies the preconditioner once, which together with LU or Cholesky is a direct solve:
+enum class KrylovMethod { CG, GMRES, BiCGStab, PreOnly };
+
+enum class Preconditioner { None, Jacobi, ILU, GAMG, LU, Cholesky };
+
+// How Matrix::Solve solves a system. PETSc command line options (e.g. -ksp_type, -pc_type) still override these. The
+// defaults are GMRES preconditioned with a Cholesky factorization (of the upper triangle), which GMRES corrects for
+// matrices that aren't symmetric.
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+struct SolverOptions {
+    KrylovMethod method = KrylovMethod::GMRES;
+    Preconditioner preconditioner = Preconditioner::Cholesky;
+    Float relative_tolerance = 1.0e-10;
+    Float absolute_tolerance = 1.0e-50;
+    Integer max_iterations = 10000;
+};
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+// CG with algebraic multigrid, for the symmetric positive definite systems of the problems:
+inline SolverOptions SymmetricSolverOptions() {
+    SolverOptions options;
+    options.method = KrylovMethod::CG;
+    options.preconditioner = Preconditioner::GAMG;
+
+    return options;
+}
+
+} // namespace plasmatic
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Utility/Utility.h"
+
+#include <vector>
+
+namespace plasmatic {
+
+// Number of nonzero blocks in each locally owned block row of a square matrix, split into the diagonal portion (columns
+// owned by this rank) and the off-diagonal portion as expected by PETSc's preallocation routines. The upper triangular
+// counts (columns >= row) are only used by symmetric storage and default to the full counts.
+class SparsityPattern {
+  public:
+    SparsityPattern(Integer global_rows, Integer block_size = 1);
+
+    Integer GlobalRows() const { return _globalRows; }
+
+    Integer LocalRows() const { return _localRows; }
+
+    Integer BlockSize() const { return _blockSize; }
+
+    Integer BlockRowStart() const { return _rowStart / _blockSize; }
+
+    Integer BlockRowEnd() const { return (_rowStart + _localRows) / _blockSize; }
+
+    bool OwnsBlockRow(Integer block_row) const { return block_row >= BlockRowStart() && block_row < BlockRowEnd(); }
+
+    // Rank that owns the block row:
+    Integer BlockRowOwner(Integer block_row) const;
+
+    void SetBlockRowNonzeros(Integer block_row, Integer diagonal, Integer off_diagonal);
+
+    void SetUpperBlockRowNonzeros(Integer block_row, Integer diagonal, Integer off_diagonal);
+
+    const std::vector<Integer> &DiagonalNonzeros() const { return _diagonalNonzeros; }
+
+    const std::vector<Integer> &OffDiagonalNonzeros() const { return _offDiagonalNonzeros; }
+
+    const std::vector<Integer> &UpperDiagonalNonzeros() const { return _upperDiagonalNonzeros; }
+
+    const std::vector<Integer> &UpperOffDiagonalNonzeros() const { return _upperOffDiagonalNonzeros; }
+
+  private:
+    Integer _globalRows;
+    Integer _localRows;
+    Integer _rowStart;
+    Integer _blockSize;
+
+    // First block row of every rank followed by the number of block rows:
+    std::vector<Integer> _blockRowStarts;
+
+    std::vector<Integer> _diagonalNonzeros;
+    std::vector<Integer> _offDiagonalNonzeros;
+    std::vector<Integer> _upperDiagonalNonzeros;
+    std::vector<Integer> _upperOffDiagonalNonzeros;
+};
+
+} // namespace plasmatic
@@ -2,28 +2,109 @@
 
 #include "Utility/Utility.h"
 
+#include "SparsityPattern.h"
+
+#include <Eigen/Dense>
 #include <petscvec.h>
 
+#include <span>
+#include <utility>
+#include <vector>
+
 namespace plasmatic {
 
+// The entries of a PETSc vector stored on this rank as one contiguous array, which is handed back to the vector when
+// the view is destroyed. The vector shouldn't be used otherwise while the view exists.
+class ConstVectorView {
+  public:
+    explicit ConstVectorView(Vec data);
+
+    ConstVectorView(const ConstVectorView &other) = delete;
+
+    ConstVectorView &operator=(const ConstVectorView &other) = delete;
+
+    ~ConstVectorView();
+
+    std::span<const Float> Values() const { return {_values, static_cast<size_t>(_size)}; }
+
+    Eigen::Map<const Eigen::VectorXd> Map() const { return {_values, _size}; }
+
+    const Float &operator[](Integer pos) const { return Values()[static_cast<size_t>(pos)]; }
+
+  private:
+    Vec _data;
+    const Float *_values;
+    Integer _size;
+};
+
+class VectorView {
+  public:
+    explicit VectorView(Vec data);
+
+    VectorView(const VectorView &other) = delete;
+
+    VectorView &operator=(const VectorView &other) = delete;
+
+    ~VectorView();
+
+    std::span<Float> Values() const { return {_values, static_cast<size_t>(_size)}; }
+
+    Eigen::Map<Eigen::VectorXd> Map() const { return {_values, _size}; }
+
+    Float &operator[](Integer pos) const { return Values()[static_cast<size_t>(pos)]; }
+
+  private:
+    Vec _data;
+    Float *_values;
+    Integer _size;
+};
+
 class Vector {
   public:
-    Vector(Integer global_size);
+    Vector(Integer global_size, Integer block_size = 1);
+
+    // Distributed like the rows of a matrix created from the same pattern:
+    Vector(const SparsityPattern &pattern);
 
     Vector(const Vector &other);
 
+    // Moves only hand over the PETSc vector; the moved from vector can only be assigned to or destroyed:
+    Vector(Vector &&other) noexcept;
+
+    Vector &operator=(const Vector &other);
+
+    Vector &operator=(Vector &&other) noexcept;
+
     ~Vector();
 
+    // How many vectors were created with VecDuplicate (copies and results of products, sums and solves) so far, for
+    // checking that no hidden copies are made:
+    static size_t NumDuplicates();
+
     Integer Size() const;
 
+    // First and one past the last entry stored on this rank:
+    std::pair<Integer, Integer> OwnershipRange() const;
+
     void AddValue(Integer pos, Float value);
 
     void SetValue(Integer pos, Float value);
 
+    void AddElementVector(std::span<const Integer> dofs, const Eigen::Ref<const Eigen::VectorXd> &values);
+
     void Assemble();
 
     Float GetValue(Integer pos);
 
+    // The entries stored on this rank (from OwnershipRange().first), for reading or writing them all at once. Values
+    // written through a view don't need Assemble():
+    ConstVectorView View() const { return ConstVectorView(_data); }
+
+    VectorView View() { return VectorView(_data); }
+
+    // Collective: copies all entries (including the ones owned by other ranks) to every rank.
+    std::vector<Float> GatherAll() const;
+
     Vector operator+(const Vector &other);
 
     Vector operator-(const Vector &other);
@@ -32,10 +113,24 @@ class Vector {
 
     Vector &operator-=(const Vector &other);
 
+    Vector &operator*=(Float factor);
+
     friend class Matrix;
+    friend class LinearSolver;
 
   private:
-    Vec _data;
+    // A vector with the same layout (size, distribution and block size) as `other` whose entries are not set, for
+    // results that overwrite all of them:
+    static Vector Duplicate(const Vector &other);
+
+    // A zero vector with the same layout as `other`:
+    static Vector WithLayoutOf(const Vector &other);
+
+    Vector() = default;
+
+    Vec _data = nullptr;
+
+    std::vector<Integer> _blockIndices;
 };
 
 } // namespace plasmatic
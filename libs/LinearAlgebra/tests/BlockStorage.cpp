@@ -0,0 +1,137 @@
+#include "LinearAlgebra/LinearAlgebra.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <map>
+
+namespace plasmatic {
+namespace {
+constexpr Integer grid_size = 16;
+constexpr Integer block_size = 3;
+constexpr Integer num_nodes = grid_size * grid_size * grid_size;
+constexpr Integer num_multiplies = 50;
+
+Integer NodeIndex(Integer ii, Integer jj, Integer kk) { return ii + grid_size * (jj + grid_size * kk); }
+
+// Pattern of a structured hexahedral grid with 3 dofs per node (every node couples to its 27 point neighborhood):
+SparsityPattern GridPattern() {
+    SparsityPattern pattern(block_size * num_nodes, block_size);
+
+    for (Integer node = pattern.BlockRowStart(); node < pattern.BlockRowEnd(); ++node) {
+        const auto ii = node % grid_size;
+        const auto jj = (node / grid_size) % grid_size;
+        const auto kk = node / (grid_size * grid_size);
+
+        Integer diagonal = 0;
+        Integer off_diagonal = 0;
+        Integer upper_diagonal = 0;
+        Integer upper_off_diagonal = 0;
+        for (Integer di = -1; di <= 1; ++di) {
+            for (Integer dj = -1; dj <= 1; ++dj) {
+                for (Integer dk = -1; dk <= 1; ++dk) {
+                    if (ii + di < 0 || ii + di >= grid_size || jj + dj < 0 || jj + dj >= grid_size || kk + dk < 0 ||
+                        kk + dk >= grid_size) {
+                        continue;
+                    }
+
+                    const auto neighbor = NodeIndex(ii + di, jj + dj, kk + dk);
+                    const auto owned = pattern.OwnsBlockRow(neighbor);
+                    diagonal += owned ? 1 : 0;
+                    off_diagonal += owned ? 0 : 1;
+                    upper_diagonal += owned && neighbor >= node ? 1 : 0;
+                    upper_off_diagonal += !owned && neighbor > node ? 1 : 0;
+                }
+            }
+        }
+
+        pattern.SetBlockRowNonzeros(node, diagonal, off_diagonal);
+        pattern.SetUpperBlockRowNonzeros(node, upper_diagonal, upper_off_diagonal);
+    }
+
+    return pattern;
+}
+
+void AssembleGrid(Matrix &mat) {
+    constexpr Integer element_dofs = 8 * block_size;
+
+    Eigen::MatrixXd element_matrix(element_dofs, element_dofs);
+    for (Integer ii = 0; ii < element_dofs; ++ii) {
+        for (Integer jj = 0; jj < element_dofs; ++jj) {
+            element_matrix(ii, jj) = 1.0 / (1.0 + static_cast<Float>(std::abs(ii - jj)));
+        }
+    }
+
+    std::vector<Integer> dofs(element_dofs);
+    for (Integer ii = 0; ii < grid_size - 1; ++ii) {
+        for (Integer jj = 0; jj < grid_size - 1; ++jj) {
+            for (Integer kk = 0; kk < grid_size - 1; ++kk) {
+                for (Integer node = 0; node < 8; ++node) {
+                    const auto node_index = NodeIndex(ii + (node & 1), jj + ((node >> 1) & 1), kk + ((node >> 2) & 1));
+                    for (Integer dof = 0; dof < block_size; ++dof) {
+                        dofs[static_cast<size_t>(block_size * node + dof)] = block_size * node_index + dof;
+                    }
+                }
+
+                mat.AddElementMatrix(dofs, element_matrix);
+            }
+        }
+    }
+
+    mat.Assemble();
+}
+} // namespace
+
+// Compares storage and SpMV throughput of the scalar and block formats on the same 3 dof per node problem
+TEST(LinearAlgebraTest, BlockStorageBenchmark) {
+    const auto pattern = GridPattern();
+
+    Vector x(block_size * num_nodes, block_size);
+    for (Integer ii = 0; ii < x.Size(); ++ii) {
+        x.SetValue(ii, 1.0 + static_cast<Float>(ii % 7));
+    }
+    x.Assemble();
+
+    std::map<MatrixFormat, Float> memory;
+    std::map<MatrixFormat, Float> checksum;
+    for (const auto &[format, name] : {std::pair{MatrixFormat::AIJ, "AIJ"}, std::pair{MatrixFormat::BlockAIJ, "BAIJ"},
+                                       std::pair{MatrixFormat::SymmetricBlockAIJ, "SBAIJ"}}) {
+        const auto assembly_start = std::chrono::steady_clock::now();
+        Matrix mat(pattern, format);
+        AssembleGrid(mat);
+        const auto assembly_end = std::chrono::steady_clock::now();
+
+        const auto info = mat.GetInfo();
+        EXPECT_EQ(info.mallocs, 0.0);
+        EXPECT_EQ(info.block_size, block_size);
+
+        // Values plus column indices (one per scalar entry for AIJ and one per block for the block formats):
+        const auto entries_per_index = format == MatrixFormat::AIJ ? 1.0 : static_cast<Float>(block_size * block_size);
+        memory[format] = info.nonzeros_allocated * static_cast<Float>(sizeof(Float)) +
+                         info.nonzeros_allocated / entries_per_index * static_cast<Float>(sizeof(Integer));
+
+        const auto multiply_start = std::chrono::steady_clock::now();
+        Float sum = 0.0;
+        for (Integer ii = 0; ii < num_multiplies; ++ii) {
+            auto y = mat * x;
+            sum += y.GetValue(ii);
+        }
+        const auto multiply_end = std::chrono::steady_clock::now();
+        checksum[format] = sum;
+
+        const auto assembly_ms = std::chrono::duration<Float, std::milli>(assembly_end - assembly_start).count();
+        const auto multiply_ms = std::chrono::duration<Float, std::milli>(multiply_end - multiply_start).count();
+        Log::Info("{:>5}: {:.0f} nonzeros allocated, {:.2f} MB, assembly {:.2f} ms, {:.3f} ms per MatMult", name,
+                  info.nonzeros_allocated, memory[format] / 1.0e6, assembly_ms, multiply_ms / num_multiplies);
+    }
+
+    EXPECT_LT(memory[MatrixFormat::BlockAIJ], memory[MatrixFormat::AIJ]);
+    EXPECT_LT(memory[MatrixFormat::SymmetricBlockAIJ], memory[MatrixFormat::BlockAIJ]);
+
+    constexpr auto tol = 1.0e-8;
+    EXPECT_NEAR(checksum[MatrixFormat::BlockAIJ], checksum[MatrixFormat::AIJ], tol * checksum[MatrixFormat::AIJ]);
+    EXPECT_NEAR(checksum[MatrixFormat::SymmetricBlockAIJ], checksum[MatrixFormat::AIJ],
+                tol * checksum[MatrixFormat::AIJ]);
+}
+} // namespace plasmatic
@@ -54,6 +54,29 @@ TEST(LinearAlgebraTest, Vector) {
     }
 }
 
+TEST(LinearAlgebraTest, VectorView) {
+    constexpr Integer size = 10;
+    Vector vec(size);
+    const auto [start, end] = vec.OwnershipRange();
+
+    {
+        auto view = vec.View();
+        EXPECT_EQ(view.Values().size(), static_cast<size_t>(end - start));
+        for (Integer ii = start; ii < end; ++ii) {
+            view[ii - start] = static_cast<Float>(ii);
+        }
+        view.Map() *= 2.0;
+    }
+
+    for (Integer ii = start; ii < end; ++ii) {
+        EXPECT_DOUBLE_EQ(vec.GetValue(ii), 2.0 * static_cast<Float>(ii));
+    }
+
+    const auto &const_vec = vec;
+    const auto view = const_vec.View();
+    EXPECT_DOUBLE_EQ(view.Map().sum(), static_cast<Float>((start + end - 1) * (end - start)));
+}
+
 TEST(LinearAlgebraTest, Matrix) {
     Matrix mat(5, 5);
 
@@ -147,6 +170,319 @@ TEST(LinearAlgebraTest, LinearSolver) {
     EXPECT_NEAR(ans.GetValue(3), 2.5, tol);
     EXPECT_NEAR(ans.GetValue(4), 1.0, tol);
 }
+
+TEST(LinearAlgebraTest, PreallocatedLinearSolver) {
+    SparsityPattern pattern(5);
+
+    EXPECT_EQ(pattern.GlobalRows(), 5);
+    EXPECT_EQ(pattern.LocalRows(), 5);
+
+    pattern.SetBlockRowNonzeros(0, 1, 0);
+    pattern.SetBlockRowNonzeros(4, 1, 0);
+    for (Integer ii = 1; ii < 4; ++ii) {
+        pattern.SetBlockRowNonzeros(ii, 3, 0);
+    }
+
+    Matrix mat(pattern);
+
+    EXPECT_EQ(mat.Rows(), 5);
+    EXPECT_EQ(mat.Cols(), 5);
+
+    mat.SetValue(0, 0, 1.0);
+    mat.SetValue(4, 4, 1.0);
+    for (Integer ii = 1; ii < 4; ++ii) {
+        mat.AddValue(ii, ii - 1, -1.0);
+        mat.AddValue(ii, ii, 2.0);
+        mat.AddValue(ii, ii + 1, -1.0);
+    }
+    mat.Assemble();
+
+    Vector rhs(5);
+
+    for (Integer ii = 0; ii < 5; ++ii) {
+        rhs.SetValue(ii, 1.0);
+    }
+
+    auto ans = mat.Solve(rhs);
+
+    constexpr auto tol = 1.0e-8;
+    EXPECT_NEAR(ans.GetValue(0), 1.0, tol);
+    EXPECT_NEAR(ans.GetValue(1), 2.5, tol);
+    EXPECT_NEAR(ans.GetValue(2), 3.0, tol);
+    EXPECT_NEAR(ans.GetValue(3), 2.5, tol);
+    EXPECT_NEAR(ans.GetValue(4), 1.0, tol);
+}
+
+TEST(LinearAlgebraTest, SolverOptions) {
+    constexpr Integer size = 20;
+    Matrix mat(size, size);
+
+    // Symmetric positive definite:
+    for (Integer ii = 0; ii < size; ++ii) {
+        mat.SetValue(ii, ii, 2.0);
+        if (ii > 0) {
+            mat.SetValue(ii, ii - 1, -1.0);
+            mat.SetValue(ii - 1, ii, -1.0);
+        }
+    }
+    mat.Assemble();
+
+    Vector rhs(size);
+    for (Integer ii = 0; ii < size; ++ii) {
+        rhs.SetValue(ii, 1.0);
+    }
+    rhs.Assemble();
+
+    // The exact solution is ii (size + 1 - ii) / 2 counting from 1:
+    const auto expected = [](Integer ii) { return static_cast<Float>((ii + 1) * (size - ii)) / 2.0; };
+
+    for (const auto &[method, preconditioner] : {std::pair{KrylovMethod::CG, Preconditioner::Jacobi},
+                                                 std::pair{KrylovMethod::CG, Preconditioner::GAMG},
+                                                 std::pair{KrylovMethod::GMRES, Preconditioner::ILU},
+                                                 std::pair{KrylovMethod::BiCGStab, Preconditioner::None},
+                                                 std::pair{KrylovMethod::PreOnly, Preconditioner::LU}}) {
+        auto options = SymmetricSolverOptions();
+        options.method = method;
+        options.preconditioner = preconditioner;
+
+        auto ans = mat.Solve(rhs, options);
+
+        constexpr auto tol = 1.0e-6;
+        for (Integer ii = 0; ii < size; ++ii) {
+            EXPECT_NEAR(ans.GetValue(ii), expected(ii), tol);
+        }
+    }
+}
+
+TEST(LinearAlgebraTest, LinearSolverReuse) {
+    constexpr Integer size = 20;
+    Matrix mat(size, size);
+    for (Integer ii = 0; ii < size; ++ii) {
+        mat.SetValue(ii, ii, 2.0);
+        if (ii > 0) {
+            mat.SetValue(ii, ii - 1, -1.0);
+            mat.SetValue(ii - 1, ii, -1.0);
+        }
+    }
+    mat.Assemble();
+
+    auto options = SymmetricSolverOptions();
+    options.method = KrylovMethod::PreOnly;
+    options.preconditioner = Preconditioner::Cholesky;
+    LinearSolver solver(mat, options);
+    EXPECT_EQ(solver.NumSetups(), 0);
+
+    // The factorization is computed once for all right hand sides:
+    constexpr auto tol = 1.0e-8;
+    for (const auto scale : {1.0, 2.0, -3.0}) {
+        Vector rhs(size);
+        for (Integer ii = 0; ii < size; ++ii) {
+            rhs.SetValue(ii, scale);
+        }
+        rhs.Assemble();
+
+        auto ans = solver.Solve(rhs);
+        EXPECT_EQ(solver.NumSetups(), 1);
+        for (Integer ii = 0; ii < size; ++ii) {
+            EXPECT_NEAR(ans.GetValue(ii), scale * static_cast<Float>((ii + 1) * (size - ii)) / 2.0, tol);
+        }
+    }
+
+    // Until the matrix changes:
+    for (Integer ii = 0; ii < size; ++ii) {
+        mat.SetValue(ii, ii, 4.0);
+    }
+    mat.Assemble();
+
+    Vector rhs(size);
+    for (Integer ii = 0; ii < size; ++ii) {
+        rhs.SetValue(ii, 1.0);
+    }
+    rhs.Assemble();
+
+    auto ans = solver.Solve(rhs);
+    EXPECT_EQ(solver.NumSetups(), 2);
+
+    auto residual = mat * ans;
+    residual -= rhs;
+    for (Integer ii = 0; ii < size; ++ii) {
+        EXPECT_NEAR(residual.GetValue(ii), 0.0, tol);
+    }
+}
+
+TEST(LinearAlgebraTest, MoveSemantics) {
+    constexpr Integer size = 10;
+    Matrix mat(size, size);
+    for (Integer ii = 0; ii < size; ++ii) {
+        mat.SetValue(ii, ii, 2.0);
+    }
+    mat.Assemble();
+
+    Vector rhs(size);
+    for (Integer ii = 0; ii < size; ++ii) {
+        rhs.SetValue(ii, 1.0);
+    }
+    rhs.Assemble();
+
+    auto options = SymmetricSolverOptions();
+    options.method = KrylovMethod::PreOnly;
+    options.preconditioner = Preconditioner::Cholesky;
+
+    // Products and solves returned by value create their result and nothing else:
+    const auto vector_duplicates = Vector::NumDuplicates();
+    auto product = mat * rhs;
+    auto ans = mat.Solve(rhs, options);
+    EXPECT_EQ(Vector::NumDuplicates(), vector_duplicates + 2);
+
+    // Moving and the variants with an output vector don't create any:
+    Vector moved = std::move(product);
+    ans = std::move(moved);
+    mat.Multiply(rhs, ans);
+    EXPECT_DOUBLE_EQ(ans.GetValue(0), 2.0);
+    mat.Solve(rhs, ans, options);
+    EXPECT_DOUBLE_EQ(ans.GetValue(0), 0.5);
+
+    LinearSolver solver(mat, options);
+    solver.Solve(ans, rhs);
+    EXPECT_DOUBLE_EQ(rhs.GetValue(size - 1), 0.25);
+    EXPECT_EQ(Vector::NumDuplicates(), vector_duplicates + 2);
+
+    // Sums and copies create one vector each:
+    auto vector_sum = rhs + ans;
+    Vector copy(vector_sum);
+    EXPECT_EQ(Vector::NumDuplicates(), vector_duplicates + 4);
+    EXPECT_DOUBLE_EQ(copy.GetValue(0), 0.75);
+
+    // Neither do moves of matrices, unlike copies and sums:
+    const auto matrix_duplicates = Matrix::NumDuplicates();
+    Matrix moved_mat = std::move(mat);
+    mat = std::move(moved_mat);
+    EXPECT_EQ(Matrix::NumDuplicates(), matrix_duplicates);
+    EXPECT_DOUBLE_EQ(mat.GetValue(0, 0), 2.0);
+
+    auto sum = mat + mat;
+    EXPECT_EQ(Matrix::NumDuplicates(), matrix_duplicates + 1);
+    EXPECT_DOUBLE_EQ(sum.GetValue(0, 0), 4.0);
+}
+
+TEST(LinearAlgebraTest, DirichletBCs) {
+    constexpr Integer size = 6;
+    const auto tridiagonal = [&]() {
+        Matrix mat(size, size);
+        for (Integer ii = 0; ii < size; ++ii) {
+            mat.SetValue(ii, ii, 2.0);
+            if (ii > 0) {
+                mat.SetValue(ii, ii - 1, -1.0);
+                mat.SetValue(ii - 1, ii, -1.0);
+            }
+        }
+        mat.Assemble();
+
+        return mat;
+    };
+
+    Vector values(size);
+    values.SetValue(0, 3.0);
+    values.SetValue(4, -2.0);
+    values.Assemble();
+
+    // The rows at once (in any order and more than once) are the same as one at a time:
+    auto batched = tridiagonal();
+    Vector batched_rhs(size);
+    batched_rhs.Assemble();
+    const std::vector<Integer> rows = {4, 0, 4, 0};
+    batched.SetDirichletBCs(rows, values, batched_rhs);
+
+    auto single = tridiagonal();
+    Vector single_rhs(size);
+    single_rhs.Assemble();
+    single.SetDirichletBC(0, values, single_rhs);
+    single.SetDirichletBC(4, values, single_rhs);
+
+    for (Integer ii = 0; ii < size; ++ii) {
+        EXPECT_DOUBLE_EQ(batched_rhs.GetValue(ii), single_rhs.GetValue(ii));
+        for (Integer jj = 0; jj < size; ++jj) {
+            EXPECT_DOUBLE_EQ(batched.GetValue(ii, jj), single.GetValue(ii, jj));
+        }
+    }
+
+    EXPECT_DOUBLE_EQ(batched_rhs.GetValue(1), 3.0);
+    EXPECT_DOUBLE_EQ(batched_rhs.GetValue(3), -2.0);
+    EXPECT_DOUBLE_EQ(batched.GetValue(4, 4), 1.0);
+    EXPECT_DOUBLE_EQ(batched.GetValue(3, 4), 0.0);
+}
+
+TEST(LinearAlgebraTest, ElementAssembly) {
+    SparsityPattern pattern(6, 3);
+    pattern.SetBlockRowNonzeros(0, 2, 0);
+    pattern.SetBlockRowNonzeros(1, 2, 0);
+
+    Matrix mat(pattern);
+
+    Eigen::MatrixXd values(6, 6);
+    for (Integer ii = 0; ii < 6; ++ii) {
+        for (Integer jj = 0; jj < 6; ++jj) {
+            values(ii, jj) = 10.0 * ii + jj;
+        }
+    }
+
+    // Whole nodal blocks (inserted blockwise):
+    const std::vector<Integer> dofs = {3, 4, 5, 0, 1, 2};
+    mat.AddElementMatrix(dofs, values);
+
+    // Partial blocks taken from a view into a larger matrix (inserted entrywise):
+    const std::vector<Integer> scalar_dofs = {1, 5};
+    mat.AddElementMatrix(scalar_dofs, values.block(0, 0, 2, 2));
+    mat.Assemble();
+
+    EXPECT_DOUBLE_EQ(mat.GetValue(3, 4), 1.0);
+    EXPECT_DOUBLE_EQ(mat.GetValue(0, 3), 30.0);
+    EXPECT_DOUBLE_EQ(mat.GetValue(2, 0), 53.0);
+    EXPECT_DOUBLE_EQ(mat.GetValue(1, 5), 43.0);
+    EXPECT_DOUBLE_EQ(mat.GetValue(5, 1), 34.0);
+
+    Vector vec(6, 3);
+    vec.AddElementVector(dofs, Eigen::VectorXd::LinSpaced(6, 0.0, 5.0));
+    vec.AddElementVector(scalar_dofs, Eigen::VectorXd::Ones(2));
+    vec.Assemble();
+
+    EXPECT_DOUBLE_EQ(vec.GetValue(0), 3.0);
+    EXPECT_DOUBLE_EQ(vec.GetValue(1), 5.0);
+    EXPECT_DOUBLE_EQ(vec.GetValue(3), 0.0);
+    EXPECT_DOUBLE_EQ(vec.GetValue(5), 3.0);
+}
+
+TEST(LinearAlgebraTest, DistributedVector) {
+    constexpr Integer block_size = 3;
+    constexpr Integer size = 4 * block_size;
+
+    SparsityPattern pattern(size, block_size);
+    for (Integer block_row = pattern.BlockRowStart(); block_row < pattern.BlockRowEnd(); ++block_row) {
+        pattern.SetBlockRowNonzeros(block_row, 1, 0);
+    }
+
+    // Vectors created from a pattern are split like the rows of the matrix:
+    Matrix mat(pattern, MatrixFormat::BlockAIJ);
+    Vector vec(pattern);
+    EXPECT_EQ(vec.OwnershipRange(), mat.OwnershipRange());
+    EXPECT_EQ(vec.OwnershipRange().first, block_size * pattern.BlockRowStart());
+    EXPECT_EQ(vec.OwnershipRange().second, block_size * pattern.BlockRowEnd());
+
+    const auto [start, end] = vec.OwnershipRange();
+    for (Integer ii = start; ii < end; ++ii) {
+        vec.SetValue(ii, static_cast<Float>(ii));
+    }
+    vec.Assemble();
+
+    const auto values = vec.GatherAll();
+    ASSERT_EQ(values.size(), static_cast<size_t>(size));
+    for (Integer ii = 0; ii < size; ++ii) {
+        EXPECT_DOUBLE_EQ(values[static_cast<size_t>(ii)], static_cast<Float>(ii));
+    }
+
+    EXPECT_GE(CommRank(), 0);
+    EXPECT_LT(CommRank(), CommSize());
+}
 } // namespace plasmatic
 
 int main(int argc, char **argv) {
@@ -0,0 +1,73 @@
+#include "interface/Mesh/ElementBlock.h"
+
+#include <algorithm>
+#include <array>
+
+namespace plasmatic {
+
+namespace {
+
+template <size_t NumNodes> std::array<Integer, NumNodes> NodeIndices(std::span<const Integer> node_indices) {
+    Check(node_indices.size() == NumNodes, "Expected {} nodes, got {}", NumNodes, node_indices.size());
+
+    std::array<Integer, NumNodes> indices = {};
+    std::copy(node_indices.begin(), node_indices.end(), indices.begin());
+
+    return indices;
+}
+
+using ElementVariant = std::variant<Line, LineOrder2, Triangle, TriangleOrder2, Tetrahedron, TetrahedronOrder2>;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+ElementVariant MakeElement(Integer vtk_cell_type, std::span<const Integer> node_indices, std::span<const Coord> nodes) {
+    switch (vtk_cell_type) {
+    case 3:
+        return Line(NodeIndices<2>(node_indices), nodes);
+    case 5:
+        return Triangle(NodeIndices<3>(node_indices), nodes);
+    case 10:
+        return Tetrahedron(NodeIndices<4>(node_indices), nodes);
+    case 21:
+        return LineOrder2(NodeIndices<3>(node_indices), nodes);
+    case 22:
+        return TriangleOrder2(NodeIndices<6>(node_indices), nodes);
+    case 24:
+        return TetrahedronOrder2(NodeIndices<10>(node_indices), nodes);
+    default:
+        Abort("Unsupported VTK cell type: {}", vtk_cell_type);
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+} // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+Integer VTKCellTypeNumNodes(Integer vtk_cell_type) {
+    switch (vtk_cell_type) {
+    case 3: // line
+        return 2;
+    case 5: // triangle
+        return 3;
+    case 10: // tetrahedron
+        return 4;
+    case 21: // quadratic line
+        return 3;
+    case 22: // quadratic triangle
+        return 6;
+    case 24: // quadratic tetrahedron
+        return 10;
+    default:
+        return -1;
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+ElementView::ElementView(Integer vtk_cell_type, std::span<const Integer> node_indices, std::span<const Coord> nodes)
+    : _element(MakeElement(vtk_cell_type, node_indices, nodes)) {}
+
+const Element &ElementView::operator*() const {
+    return std::visit([](const auto &element) -> const Element & { return element; }, _element);
+}
+
+} // namespace plasmatic
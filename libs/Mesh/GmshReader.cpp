@@ -0,0 +1,269 @@
+#include "GmshReader.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace plasmatic {
+
+namespace {
+
+bool IsWhitespace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+} // namespace
+
+std::string_view GmshReader::ReadLine() {
+    auto end = std::min(_contents.find('\n', _position), _contents.size());
+    auto line = _contents.substr(_position, end - _position);
+    _position = std::min(end + 1, _contents.size());
+
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    return line;
+}
+
+std::string_view GmshReader::ReadToken() {
+    SkipWhitespace();
+
+    auto begin = _position;
+    while (_position < _contents.size() && !IsWhitespace(_contents[_position])) {
+        ++_position;
+    }
+
+    return _contents.substr(begin, _position - begin);
+}
+
+std::string_view GmshReader::ReadQuoted() {
+    SkipWhitespace();
+    Check(_position < _contents.size() && _contents[_position] == '"', "Expected a quoted string at offset {}",
+          _position);
+
+    auto end = _contents.find('"', _position + 1);
+    Check(end != std::string_view::npos, "Unterminated quoted string at offset {}", _position);
+
+    auto value = _contents.substr(_position + 1, end - _position - 1);
+    _position = end + 1;
+
+    return value;
+}
+
+void GmshReader::ReadFormat() {
+    const auto version = ReadToken();
+    const auto file_type = ParseText<Integer>();
+    const auto size_width = ParseText<size_t>();
+    ReadLine();
+
+    Check(version == "4.1", "Unsupported Gmsh file format version: {}", version);
+    Check(file_type == 0 || file_type == 1, "Unknown Gmsh file type: {}", file_type);
+
+    if (file_type == 0) {
+        return;
+    }
+
+    Check(size_width == sizeof(uint32_t) || size_width == sizeof(uint64_t), "Unsupported size_t width: {}",
+          size_width);
+
+    // The writer stores the integer 1 so that the reader can tell whether its byte order differs:
+    const auto one = ReadBinary<int32_t>();
+    Check(one == 1 || SwapBytes(one) == 1, "Invalid binary Gmsh header");
+
+    _binary = true;
+    _swapBytes = one != 1;
+    _sizeWidth = size_width;
+
+    ReadLine();
+}
+
+Integer GmshReader::ReadInt() { return _binary ? ReadBinary<int32_t>() : ParseText<Integer>(); }
+
+size_t GmshReader::ReadSize() {
+    if (!_binary) {
+        return ParseText<size_t>();
+    }
+
+    return _sizeWidth == sizeof(uint64_t) ? ReadBinary<uint64_t>() : ReadBinary<uint32_t>();
+}
+
+Float GmshReader::ReadFloat() { return _binary ? ReadBinary<Float>() : ParseText<Float>(); }
+
+void GmshReader::ReadCoords(std::span<Coord> coords) {
+    static_assert(sizeof(Coord) == 3 * sizeof(Float), "Coord must be three packed doubles");
+
+    if (!_binary) {
+        for (auto &coord : coords) {
+            coord = {.x = ReadFloat(), .y = ReadFloat(), .z = ReadFloat()};
+        }
+        return;
+    }
+
+    Check(_position + coords.size_bytes() <= _contents.size(), "Unexpected end of binary data at offset {}",
+          _position);
+
+    std::memcpy(coords.data(), &_contents[_position], coords.size_bytes());
+    _position += coords.size_bytes();
+
+    if (_swapBytes) {
+        for (auto &coord : coords) {
+            coord = {.x = SwapBytes(coord.x), .y = SwapBytes(coord.y), .z = SwapBytes(coord.z)};
+        }
+    }
+}
+
+void GmshReader::ReadSizes(std::span<uint64_t> values) {
+    if (!_binary || _sizeWidth != sizeof(uint64_t) || _swapBytes) {
+        for (auto &value : values) {
+            value = ReadSize();
+        }
+        return;
+    }
+
+    Check(_position + values.size_bytes() <= _contents.size(), "Unexpected end of binary data at offset {}",
+          _position);
+
+    std::memcpy(values.data(), &_contents[_position], values.size_bytes());
+    _position += values.size_bytes();
+}
+
+void GmshReader::SkipSizes(size_t count) {
+    if (!_binary) {
+        for (size_t ii = 0; ii < count; ++ii) {
+            ReadToken();
+        }
+        return;
+    }
+
+    Check(_position + count * _sizeWidth <= _contents.size(), "Unexpected end of binary data at offset {}", _position);
+    _position += count * _sizeWidth;
+}
+
+std::vector<size_t> GmshReader::SkipRecords(size_t count, size_t record_bytes, size_t stride) {
+    std::vector<size_t> offsets;
+    offsets.reserve(count / stride + 1);
+
+    if (_binary) {
+        for (size_t ii = 0; ii < count; ii += stride) {
+            offsets.push_back(_position + ii * record_bytes);
+        }
+
+        Check(_position + count * record_bytes <= _contents.size(), "Unexpected end of binary data at offset {}",
+              _position);
+        _position += count * record_bytes;
+
+        return offsets;
+    }
+
+    SkipWhitespace();
+    for (size_t ii = 0; ii < count; ++ii) {
+        if (ii % stride == 0) {
+            offsets.push_back(_position);
+        }
+
+        auto end = _contents.find('\n', _position);
+        Check(end != std::string_view::npos || ii + 1 == count, "Unexpected end of file at offset {}", _position);
+        _position = std::min(end, _contents.size() - 1) + 1;
+    }
+
+    return offsets;
+}
+
+template <typename T> T GmshReader::ParseText() {
+    SkipWhitespace();
+
+    T value = {};
+    const auto *begin = _contents.data() + _position; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto *end = _contents.data() + _contents.size(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto [next, error] = std::from_chars(begin, end, value);
+    Check(error == std::errc(), "Could not parse '{}' as a number at offset {}",
+          _contents.substr(_position, std::min<size_t>(_contents.size() - _position, 32)), _position);
+
+    _position += static_cast<size_t>(next - begin);
+
+    return value;
+}
+
+void GmshReader::SkipWhitespace() {
+    while (_position < _contents.size() && IsWhitespace(_contents[_position])) {
+        ++_position;
+    }
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+Integer GmshElementNumNodes(Integer element_type) {
+    switch (element_type) {
+    case 15: // point
+        return 1;
+    case 1: // 2-node line
+        return 2;
+    case 2: // 3-node triangle
+    case 8: // 3-node line
+        return 3;
+    case 3: // 4-node quadrangle
+    case 4: // 4-node tetrahedron
+        return 4;
+    case 7: // 5-node pyramid
+        return 5;
+    case 6: // 6-node prism
+    case 9: // 6-node triangle
+        return 6;
+    case 5:  // 8-node hexahedron
+    case 16: // 8-node quadrangle
+        return 8;
+    case 10: // 9-node quadrangle
+        return 9;
+    case 11: // 10-node tetrahedron
+        return 10;
+    case 19: // 13-node pyramid
+        return 13;
+    case 14: // 14-node pyramid
+        return 14;
+    case 18: // 15-node prism
+        return 15;
+    case 13: // 18-node prism
+        return 18;
+    case 17: // 20-node hexahedron
+        return 20;
+    case 12: // 27-node hexahedron
+        return 27;
+    default:
+        return -1;
+    }
+}
+
+Integer GmshElementDimension(Integer element_type) {
+    switch (element_type) {
+    case 1: // 2-node line
+    case 8: // 3-node line
+        return 1;
+    case 2: // 3-node triangle
+    case 9: // 6-node triangle
+        return 2;
+    case 4:  // 4-node tetrahedron
+    case 11: // 10-node tetrahedron
+        return 3;
+    default:
+        return -1;
+    }
+}
+
+Integer GmshElementVTKCellType(Integer element_type) {
+    switch (element_type) {
+    case 1: // 2-node line
+        return 3;
+    case 2: // 3-node triangle
+        return 5;
+    case 4: // 4-node tetrahedron
+        return 10;
+    case 8: // 3-node line
+        return 21;
+    case 9: // 6-node triangle
+        return 22;
+    case 11: // 10-node tetrahedron
+        return 24;
+    default:
+        Abort("Unsupported Gmsh element type: {}", element_type);
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+} // namespace plasmatic
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "interface/Mesh/Coord.h"
+
+#include "Utility/Utility.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace plasmatic {
+
+// Cursor over the contents of a Gmsh 4.1 file that parses values in place, without copying lines. The same calls read
+// both ASCII and binary sections: ASCII values are whitespace separated text, while binary values are stored as ints,
+// size_ts (of the width given in the file header) and doubles in the byte order of the machine that wrote the file.
+class GmshReader {
+  public:
+    GmshReader(std::string_view contents) : _contents(contents) {}
+
+    bool AtEnd() const { return _position >= _contents.size(); }
+
+    size_t Position() const { return _position; }
+
+    void Seek(size_t position) { _position = position; }
+
+    // Rest of the current line, without the line break (section headers are always text):
+    std::string_view ReadLine();
+
+    std::string_view ReadToken();
+
+    // Reads a double quoted string, which may contain spaces (the quotes are not part of the result):
+    std::string_view ReadQuoted();
+
+    // Reads the rest of the $MeshFormat section and switches to binary values if the file is binary:
+    void ReadFormat();
+
+    bool IsBinary() const { return _binary; }
+
+    Integer ReadInt();
+
+    // Reads an int that is stored as text even in binary files (e.g. in $PhysicalNames):
+    Integer ReadTextInt() { return ParseText<Integer>(); }
+
+    size_t ReadSize();
+
+    Float ReadFloat();
+
+    // Reads the x, y, z values of `coords.size()` nodes, which is a single copy for binary files:
+    void ReadCoords(std::span<Coord> coords);
+
+    // Reads `values.size()` size_t values, which is a single copy for binary files with 64 bit size_ts:
+    void ReadSizes(std::span<uint64_t> values);
+
+    // Skips `count` size_t values:
+    void SkipSizes(size_t count);
+
+    // Skips `count` records (one line each in ASCII files and `record_bytes` bytes each in binary files) and returns
+    // the offset of every `stride`-th record, so that the records can be parsed in chunks later on:
+    std::vector<size_t> SkipRecords(size_t count, size_t record_bytes, size_t stride);
+
+    size_t SizeWidth() const { return _sizeWidth; }
+
+  private:
+    template <typename T> T ParseText();
+
+    template <typename T> T ReadBinary() {
+        Check(_position + sizeof(T) <= _contents.size(), "Unexpected end of binary data at offset {}", _position);
+
+        T value = {};
+        std::memcpy(&value, &_contents[_position], sizeof(T));
+        _position += sizeof(T);
+
+        return _swapBytes ? SwapBytes(value) : value;
+    }
+
+    template <typename T> static T SwapBytes(T value) {
+        std::array<char, sizeof(T)> bytes = {};
+        std::memcpy(bytes.data(), &value, sizeof(T));
+        std::reverse(bytes.begin(), bytes.end());
+        std::memcpy(&value, bytes.data(), sizeof(T));
+
+        return value;
+    }
+
+    void SkipWhitespace();
+
+    std::string_view _contents;
+    size_t _position = 0;
+
+    bool _binary = false;
+    bool _swapBytes = false;
+    size_t _sizeWidth = sizeof(uint64_t);
+};
+
+// Number of nodes of a Gmsh element type, or -1 if the type is unknown:
+Integer GmshElementNumNodes(Integer element_type);
+
+// Dimension of a Gmsh element type, or -1 if meshes don't support the type:
+Integer GmshElementDimension(Integer element_type);
+
+// VTK cell type of a supported Gmsh element type:
+Integer GmshElementVTKCellType(Integer element_type);
+
+} // namespace plasmatic
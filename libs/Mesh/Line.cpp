@@ -4,8 +4,8 @@
 
 namespace plasmatic {
 
-Line::Line(const std::array<Integer, 2> &node_indices, std::shared_ptr<std::vector<Coord>> nodes)
-    : _nodeIndices(node_indices), _nodes(std::move(nodes)) {}
+Line::Line(const std::array<Integer, 2> &node_indices, std::span<const Coord> nodes)
+    : _nodeIndices(node_indices), _nodes(nodes) {}
 
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 Float Line::ShapeFn(Integer index, Float xi) const {
@@ -36,12 +36,12 @@ Float Line::ShapeFnDerivative(Integer index, Integer dimension, [[maybe_unused]]
 }
 
 Float Line::ShapeFn([[maybe_unused]] Integer index, [[maybe_unused]] const Coord &coord) const {
-    auto x0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].x;
-    auto y0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].y;
-    auto z0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].z;
-    auto x1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].x;
-    auto y1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].y;
-    auto z1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].z;
+    auto x0 = _nodes[static_cast<size_t>(_nodeIndices[0])].x;
+    auto y0 = _nodes[static_cast<size_t>(_nodeIndices[0])].y;
+    auto z0 = _nodes[static_cast<size_t>(_nodeIndices[0])].z;
+    auto x1 = _nodes[static_cast<size_t>(_nodeIndices[1])].x;
+    auto y1 = _nodes[static_cast<size_t>(_nodeIndices[1])].y;
+    auto z1 = _nodes[static_cast<size_t>(_nodeIndices[1])].z;
 
     const auto length = std::sqrt(std::pow(x1 - x0, 2) + std::pow(y1 - y0, 2) + std::pow(z1 - z0, 2));
 
@@ -52,12 +52,12 @@ Float Line::ShapeFn([[maybe_unused]] Integer index, [[maybe_unused]] const Coord
 }
 
 Float Line::ShapeFnDerivative(Integer index, Integer dimension, [[maybe_unused]] const Coord &coord) const {
-    auto x0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].x;
-    auto y0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].y;
-    auto z0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].z;
-    auto x1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].x;
-    auto y1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].y;
-    auto z1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].z;
+    auto x0 = _nodes[static_cast<size_t>(_nodeIndices[0])].x;
+    auto y0 = _nodes[static_cast<size_t>(_nodeIndices[0])].y;
+    auto z0 = _nodes[static_cast<size_t>(_nodeIndices[0])].z;
+    auto x1 = _nodes[static_cast<size_t>(_nodeIndices[1])].x;
+    auto y1 = _nodes[static_cast<size_t>(_nodeIndices[1])].y;
+    auto z1 = _nodes[static_cast<size_t>(_nodeIndices[1])].z;
 
     const auto length = std::sqrt(std::pow(x1 - x0, 2) + std::pow(y1 - y0, 2) + std::pow(z1 - z0, 2));
 
@@ -68,11 +68,11 @@ Float Line::ShapeFnDerivative(Integer index, Integer dimension, [[maybe_unused]]
 
     for (size_t ii = 0; ii < 2; ++ii) {
         jacobian(0, 0) +=
-            (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].x * ShapeFnDerivative(static_cast<Integer>(ii), 0, xi);
+            _nodes[static_cast<size_t>(_nodeIndices[ii])].x * ShapeFnDerivative(static_cast<Integer>(ii), 0, xi);
         jacobian(0, 1) +=
-            (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].y * ShapeFnDerivative(static_cast<Integer>(ii), 0, xi);
+            _nodes[static_cast<size_t>(_nodeIndices[ii])].y * ShapeFnDerivative(static_cast<Integer>(ii), 0, xi);
         jacobian(0, 2) +=
-            (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].z * ShapeFnDerivative(static_cast<Integer>(ii), 0, xi);
+            _nodes[static_cast<size_t>(_nodeIndices[ii])].z * ShapeFnDerivative(static_cast<Integer>(ii), 0, xi);
     }
 
     Eigen::VectorXd shape_fn_derivs = Eigen::VectorXd::Zero(1);
@@ -87,12 +87,12 @@ Float Line::ShapeFnDerivative(Integer index, Integer dimension, [[maybe_unused]]
 }
 
 Float Line::Integrate(const std::function<Float(const Coord &)> integrand) const {
-    auto x0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].x;
-    auto y0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].y;
-    auto z0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].z;
-    auto x1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].x;
-    auto y1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].y;
-    auto z1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].z;
+    auto x0 = _nodes[static_cast<size_t>(_nodeIndices[0])].x;
+    auto y0 = _nodes[static_cast<size_t>(_nodeIndices[0])].y;
+    auto z0 = _nodes[static_cast<size_t>(_nodeIndices[0])].z;
+    auto x1 = _nodes[static_cast<size_t>(_nodeIndices[1])].x;
+    auto y1 = _nodes[static_cast<size_t>(_nodeIndices[1])].y;
+    auto z1 = _nodes[static_cast<size_t>(_nodeIndices[1])].z;
 
     // NOLINTNEXTLINE(clang-diagnostic-pre-c++20-compat-pedantic)
     Coord midpoint = {.x = 0.5 * (x0 + x1), .y = 0.5 * (y0 + y1), .z = 0.5 * (z0 + z1)};
@@ -106,12 +106,12 @@ Float Line::Integrate(const std::function<Float(const Coord &)> integrand) const
 
 Eigen::MatrixXd Line::Integrate(const std::function<Eigen::MatrixXd(const Coord &)> integrand,
                                 [[maybe_unused]] Integer rows, [[maybe_unused]] Integer cols) const {
-    auto x0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].x;
-    auto y0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].y;
-    auto z0 = (*_nodes)[static_cast<size_t>(_nodeIndices[0])].z;
-    auto x1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].x;
-    auto y1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].y;
-    auto z1 = (*_nodes)[static_cast<size_t>(_nodeIndices[1])].z;
+    auto x0 = _nodes[static_cast<size_t>(_nodeIndices[0])].x;
+    auto y0 = _nodes[static_cast<size_t>(_nodeIndices[0])].y;
+    auto z0 = _nodes[static_cast<size_t>(_nodeIndices[0])].z;
+    auto x1 = _nodes[static_cast<size_t>(_nodeIndices[1])].x;
+    auto y1 = _nodes[static_cast<size_t>(_nodeIndices[1])].y;
+    auto z1 = _nodes[static_cast<size_t>(_nodeIndices[1])].z;
 
     // NOLINTNEXTLINE(clang-diagnostic-pre-c++20-compat-pedantic)
     Coord midpoint = {.x = 0.5 * (x0 + x1), .y = 0.5 * (y0 + y1), .z = 0.5 * (z0 + z1)};
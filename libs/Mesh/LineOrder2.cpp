@@ -4,8 +4,8 @@
 
 namespace plasmatic {
 
-LineOrder2::LineOrder2(const std::array<Integer, 3> &node_indices, std::shared_ptr<std::vector<Coord>> nodes)
-    : _nodeIndices(node_indices), _nodes(std::move(nodes)) {}
+LineOrder2::LineOrder2(const std::array<Integer, 3> &node_indices, std::span<const Coord> nodes)
+    : _nodeIndices(node_indices), _nodes(nodes) {}
 
 Float LineOrder2::ComputeLength(const Coord &p0, const Coord &p1) {
     return std::sqrt(std::pow(p1.x - p0.x, 2) + std::pow(p1.y - p0.y, 2) + std::pow(p1.z - p0.z, 2));
@@ -13,8 +13,8 @@ Float LineOrder2::ComputeLength(const Coord &p0, const Coord &p1) {
 
 Float LineOrder2::PhysicalToParentCoords(const Coord &coord) const {
     const auto xi =
-        ComputeLength((*_nodes)[static_cast<size_t>(_nodeIndices[0])], coord) /
-        ComputeLength((*_nodes)[static_cast<size_t>(_nodeIndices[0])], (*_nodes)[static_cast<size_t>(_nodeIndices[1])]);
+        ComputeLength(_nodes[static_cast<size_t>(_nodeIndices[0])], coord) /
+        ComputeLength(_nodes[static_cast<size_t>(_nodeIndices[0])], _nodes[static_cast<size_t>(_nodeIndices[1])]);
     return xi;
 }
 
@@ -27,9 +27,9 @@ Coord LineOrder2::ParentToPhysicalCoords(const Float &xi) const {
     // NOLINTNEXTLINE(clang-diagnostic-pre-c++20-compat-pedantic)
     Coord point = {.x = 0.0, .y = 0.0, .z = 0.0};
     for (size_t ii = 0; ii < lambda.size(); ++ii) {
-        point.x += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].x * lambda[ii];
-        point.y += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].y * lambda[ii];
-        point.z += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].z * lambda[ii];
+        point.x += _nodes[static_cast<size_t>(_nodeIndices[ii])].x * lambda[ii];
+        point.y += _nodes[static_cast<size_t>(_nodeIndices[ii])].y * lambda[ii];
+        point.z += _nodes[static_cast<size_t>(_nodeIndices[ii])].z * lambda[ii];
     }
 
     return point;
@@ -90,7 +90,7 @@ Float LineOrder2::ShapeFnDerivative(Integer index, Integer dimension, [[maybe_un
 
     for (size_t ii = 0; ii < static_cast<size_t>(this->NumNodes()); ++ii) {
         jacobian(0, 0) +=
-            (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].x * ShapeFnDerivative(static_cast<Integer>(ii), 0, xi);
+            _nodes[static_cast<size_t>(_nodeIndices[ii])].x * ShapeFnDerivative(static_cast<Integer>(ii), 0, xi);
     }
 
     Eigen::VectorXd shape_fn_derivs = Eigen::VectorXd::Zero(1);
@@ -117,7 +117,7 @@ Float LineOrder2::Integrate(const std::function<Float(const Coord &)> integrand)
         Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(1, 1);
         for (size_t kk = 0; kk < static_cast<size_t>(this->NumNodes()); ++kk) {
             for (Integer jj = 0; jj < 1; ++jj) {
-                jacobian(jj, 0) += (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].x *
+                jacobian(jj, 0) += _nodes[static_cast<size_t>(_nodeIndices[kk])].x *
                                    ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii]);
             }
         }
@@ -142,7 +142,7 @@ Eigen::MatrixXd LineOrder2::Integrate(const std::function<Eigen::MatrixXd(const
         Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(1, 1);
         for (size_t kk = 0; kk < static_cast<size_t>(this->NumNodes()); ++kk) {
             for (Integer jj = 0; jj < 1; ++jj) {
-                jacobian(jj, 0) += (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].x *
+                jacobian(jj, 0) += _nodes[static_cast<size_t>(_nodeIndices[kk])].x *
                                    ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii]);
             }
         }
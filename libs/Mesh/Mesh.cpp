@@ -1,349 +1,340 @@
 #include "interface/Mesh/Mesh.h"
+#include "GmshReader.h"
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
-#include <sstream>
+#include <span>
 
 namespace plasmatic {
 
-Mesh::Mesh(const std::filesystem::path &filename) : _nodes(std::make_shared<std::vector<Coord>>()) {
+namespace {
+
+// Node of the element at position ii in VTK's node ordering (which swaps the last two nodes of quadratic tetrahedra):
+Integer VTKNodeIndex(Integer vtk_cell_type, std::span<const Integer> element_nodes, size_t ii) {
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    if (vtk_cell_type == 24 && ii == 8) {
+        return element_nodes[9];
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    if (vtk_cell_type == 24 && ii == 9) {
+        return element_nodes[8];
+    }
+
+    return element_nodes[ii];
+}
+
+// Makes room for `count` more values while keeping the geometric growth of the vector, since a mesh can have many
+// blocks of elements of the same dimension:
+template <typename T> void ReserveMore(std::vector<T> &values, size_t count) {
+    const auto size = values.size() + count;
+    if (size > values.capacity()) {
+        values.reserve(std::max(size, 2 * values.capacity()));
+    }
+}
+
+// Current index of every node or element by its index in the Gmsh file (the identity if the mesh wasn't reordered):
+std::vector<Integer> CurrentIndices(const std::vector<Integer> &original_indices, size_t size) {
+    std::vector<Integer> current_indices(size);
+    for (size_t ii = 0; ii < size; ++ii) {
+        const auto original = original_indices.empty() ? ii : static_cast<size_t>(original_indices[ii]);
+        current_indices[original] = static_cast<Integer>(ii);
+    }
+
+    return current_indices;
+}
+
+} // namespace
+
+Mesh::Mesh(const std::filesystem::path &filename, Integer num_threads, bool use_cache, size_t chunk_size) {
     Log::Info("Reading mesh from file '{}'", filename.string());
-    std::ifstream in(filename);
 
-    std::string line;
+    MappedFile file(filename);
+    ThreadPool pool(num_threads > 0 ? num_threads : ThreadPool::HardwareThreads());
+    _numThreads = pool.NumThreads();
+
+    const auto checksum = use_cache ? Checksum(file.Contents()) : 0;
+    if (!use_cache || !ReadCache(CacheFilename(filename), file.Size(), checksum)) {
+        ReadGmsh(file.Contents(), pool, chunk_size);
+
+        if (use_cache) {
+            WriteCache(CacheFilename(filename), file.Size(), checksum);
+        }
+    }
+
+    Log::Info("Num nodes read = {}", _nodes.size());
+    for (Integer ii = 0; ii < 4; ++ii) {
+        Log::Info("Num elements read = {} (dimension {})", GetNumElements(ii), ii);
+    }
+}
+
+const ElementBlock &Mesh::FindElementBlock(Integer dimension, Integer element_id) const {
+    const auto &blocks = _elementBlocks.at(static_cast<size_t>(dimension));
+
+    // Usually every dimension has a single block:
+    auto block = std::upper_bound(blocks.begin(), blocks.end(), element_id,
+                                  [](Integer id, const ElementBlock &rhs) { return id < rhs.first_element; });
+    Check(block != blocks.begin(), "Invalid element id {} of dimension {}", element_id, dimension);
+
+    return *std::prev(block);
+}
+
+std::filesystem::path Mesh::CacheFilename(const std::filesystem::path &filename) {
+    return filename.string() + ".cache";
+}
+
+void Mesh::ReadGmsh(std::string_view contents, ThreadPool &pool, size_t chunk_size) {
+    Check(chunk_size > 0, "The chunk size must be positive");
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    GmshReader in(contents);
 
     // Maps physical tags to physical names
     std::unordered_map<Integer, std::string> physical_tags;
 
-    while (std::getline(in, line)) {
+    while (!in.AtEnd()) {
+        const auto line = in.ReadLine();
 
-        if (line == "$PhysicalNames") {
-            Integer num_physical_entities = 0;
+        if (line == "$MeshFormat") {
+            in.ReadFormat();
+        }
 
-            {
-                std::getline(in, line);
-                std::stringstream ss(line);
-                ss >> num_physical_entities;
-            }
+        if (line == "$PhysicalNames") {
+            // Always stored as text, even in binary files:
+            const auto num_physical_entities = in.ReadTextInt();
 
             for (Integer ii = 0; ii < num_physical_entities; ++ii) {
-                Integer physical_dim = 0;
-                Integer physical_tag = 0;
-                std::string name;
-                {
-                    std::getline(in, line);
-                    std::stringstream ss(line);
-                    ss >> physical_dim >> physical_tag >> name;
-                }
-
-                // Remove leading and trailing quotes:
-                name.erase(0, 1);
-                name.erase(name.size() - 1);
+                in.ReadToken(); // dimension
+                const auto physical_tag = in.ReadTextInt();
+                const auto name = in.ReadQuoted();
 
-                physical_tags.insert({physical_tag, name});
+                physical_tags.insert({physical_tag, std::string(name)});
             }
         }
 
         if (line == "$Entities") {
-            Integer num_points = 0;
-            Integer num_curves = 0;
-            Integer num_surfaces = 0;
-            Integer num_volumes = 0;
-
-            {
-                std::getline(in, line);
-                std::stringstream ss(line);
-                ss >> num_points >> num_curves >> num_surfaces >> num_volumes;
+            std::array<size_t, 4> num_entities = {};
+            for (auto &count : num_entities) {
+                count = in.ReadSize();
             }
 
-            for (Integer ii = 0; ii < num_points; ++ii) {
-                Integer point_tag = 0;
-                Float x = 0;
-                Float y = 0;
-                Float z = 0;
-                Integer num_physical_tags = 0;
+            for (size_t dimension = 0; dimension < num_entities.size(); ++dimension) {
+                for (size_t ii = 0; ii < num_entities[dimension]; ++ii) {
+                    const auto entity_tag = in.ReadInt();
 
-                std::getline(in, line);
-                std::stringstream ss(line);
-                ss >> point_tag >> x >> y >> z >> num_physical_tags;
+                    // Points have their position, the others their bounding box:
+                    const auto num_coordinates = dimension == 0 ? 3 : 6;
+                    for (Integer jj = 0; jj < num_coordinates; ++jj) {
+                        in.ReadFloat();
+                    }
 
-                for (Integer jj = 0; jj < num_physical_tags; ++jj) {
-                    Integer physical_tag = 0;
-                    ss >> physical_tag;
+                    const auto num_physical_tags = in.ReadSize();
+                    for (size_t jj = 0; jj < num_physical_tags; ++jj) {
+                        const auto physical_tag = in.ReadInt();
 
-                    _physicalEntities[physical_tags.at(physical_tag)][0].push_back(point_tag);
-                }
-            }
+                        _physicalEntities[physical_tags.at(physical_tag)][dimension].push_back(entity_tag);
+                    }
 
-            for (Integer ii = 0; ii < num_curves; ++ii) {
-                Integer curve_tag = 0;
-                Float min_x = 0;
-                Float min_y = 0;
-                Float min_z = 0;
-                Float max_x = 0;
-                Float max_y = 0;
-                Float max_z = 0;
-                Integer num_physical_tags = 0;
-
-                std::getline(in, line);
-                std::stringstream ss(line);
-                ss >> curve_tag >> min_x >> min_y >> min_z >> max_x >> max_y >> max_z >> num_physical_tags;
-
-                for (Integer jj = 0; jj < num_physical_tags; ++jj) {
-                    Integer physical_tag = 0;
-                    ss >> physical_tag;
-
-                    _physicalEntities[physical_tags.at(physical_tag)][1].push_back(curve_tag);
+                    // Skip the bounding entities:
+                    if (dimension > 0) {
+                        const auto num_bounding_entities = in.ReadSize();
+                        for (size_t jj = 0; jj < num_bounding_entities; ++jj) {
+                            in.ReadInt();
+                        }
+                    }
                 }
             }
+        }
 
-            for (Integer ii = 0; ii < num_surfaces; ++ii) {
-                Integer surface_tag = 0;
-                Float min_x = 0;
-                Float min_y = 0;
-                Float min_z = 0;
-                Float max_x = 0;
-                Float max_y = 0;
-                Float max_z = 0;
-                Integer num_physical_tags = 0;
-
-                std::getline(in, line);
-                std::stringstream ss(line);
-                ss >> surface_tag >> min_x >> min_y >> min_z >> max_x >> max_y >> max_z >> num_physical_tags;
-
-                for (Integer jj = 0; jj < num_physical_tags; ++jj) {
-                    Integer physical_tag = 0;
-                    ss >> physical_tag;
-
-                    _physicalEntities[physical_tags.at(physical_tag)][2].push_back(surface_tag);
-                }
-            }
+        if (line == "$Nodes") {
+            ReadNodes(in, pool, chunk_size);
+        }
 
-            for (Integer ii = 0; ii < num_volumes; ++ii) {
-                Integer volume_tag = 0;
-                Float min_x = 0;
-                Float min_y = 0;
-                Float min_z = 0;
-                Float max_x = 0;
-                Float max_y = 0;
-                Float max_z = 0;
-                Integer num_physical_tags = 0;
-
-                std::getline(in, line);
-                std::stringstream ss(line);
-                ss >> volume_tag >> min_x >> min_y >> min_z >> max_x >> max_y >> max_z >> num_physical_tags;
-
-                for (Integer jj = 0; jj < num_physical_tags; ++jj) {
-                    Integer physical_tag = 0;
-                    ss >> physical_tag;
-
-                    _physicalEntities[physical_tags.at(physical_tag)][3].push_back(volume_tag);
-                }
-            }
+        if (line == "$Elements") {
+            ReadElements(in, pool, chunk_size);
         }
+    }
 
-        if (line == "$Nodes") {
-            Integer num_entity_blocks = 0;
-            Integer num_nodes = 0;
+    const auto seconds = std::chrono::duration<Float>(std::chrono::steady_clock::now() - start_time).count();
+    constexpr Float bytes_per_megabyte = 1024.0 * 1024.0;
+    const auto megabytes = static_cast<Float>(contents.size()) / bytes_per_megabyte;
+    Log::Info("Read {:.1f} MB ({}) in {:.3f} s ({:.1f} MB/s, {} threads)", megabytes,
+              in.IsBinary() ? "binary" : "ASCII", seconds, seconds > 0.0 ? megabytes / seconds : 0.0,
+              pool.NumThreads());
+}
 
-            {
-                std::getline(in, line);
-                std::stringstream ss(line);
-                ss >> num_entity_blocks >> num_nodes;
-            }
+void Mesh::ReadNodes(GmshReader &in, ThreadPool &pool, size_t chunk_size) {
+    const auto num_entity_blocks = in.ReadSize();
+    const auto num_nodes = in.ReadSize();
+    in.SkipSizes(2); // min and max node tags
 
-            for (Integer ii = 0; ii < num_entity_blocks; ++ii) {
-                Integer entity_dim = 0;
-                Integer entity_tag = 0;
-                Integer parametric = 0;
-                Integer nodes_in_block = 0;
-                {
-                    std::getline(in, line);
-                    std::stringstream ss(line);
-                    ss >> entity_dim >> entity_tag >> parametric >> nodes_in_block;
-                }
+    _nodes.reserve(_nodes.size() + num_nodes);
 
-                for (Integer jj = 0; jj < nodes_in_block; ++jj) {
-                    std::getline(in, line); // node tags
-                }
+    // Only the block headers are parsed here. The coordinates are located and then parsed in parallel, in chunks of at
+    // most chunk_size nodes, straight into their place in _nodes:
+    struct Chunk {
+        size_t offset;
+        size_t first_node;
+        size_t num_nodes;
+        Integer num_parametric;
+    };
 
-                for (Integer jj = 0; jj < nodes_in_block; ++jj) {
-                    Coord coord;
+    std::vector<Chunk> chunks;
 
-                    std::getline(in, line); // node coords
-                    std::stringstream ss(line);
-                    ss >> coord.x >> coord.y >> coord.z;
+    for (size_t ii = 0; ii < num_entity_blocks; ++ii) {
+        const auto entity_dim = in.ReadInt();
+        const auto entity_tag = in.ReadInt();
+        const auto parametric = in.ReadInt();
+        const auto nodes_in_block = in.ReadSize();
 
-                    constexpr auto dimension = 0; // 0d
+        // Node tags are expected to be consecutive, so they are skipped:
+        in.SkipSizes(nodes_in_block);
 
-                    _entities[entity_tag][static_cast<size_t>(dimension)].push_back(
-                        static_cast<Integer>(_nodes->size()));
-                    _nodes->push_back(coord);
-                }
-            }
+        const auto first_node = _nodes.size();
+        _nodes.resize(first_node + nodes_in_block);
+
+        constexpr auto dimension = 0; // 0d
+        auto &entity_nodes = _entities[entity_tag][static_cast<size_t>(dimension)];
+        for (size_t jj = 0; jj < nodes_in_block; ++jj) {
+            entity_nodes.push_back(static_cast<Integer>(first_node + jj));
         }
 
-        if (line == "$Elements") {
-            Integer num_entity_blocks = 0;
-            Integer num_elements = 0;
+        // Parametric coordinates follow the position but are not used:
+        const auto num_parametric = parametric != 0 ? entity_dim : 0;
+        const auto offsets =
+            in.SkipRecords(nodes_in_block, static_cast<size_t>(3 + num_parametric) * sizeof(Float), chunk_size);
 
-            {
-                std::getline(in, line);
-                std::stringstream ss(line);
-                ss >> num_entity_blocks >> num_elements;
-            }
+        for (size_t jj = 0; jj < offsets.size(); ++jj) {
+            chunks.push_back({.offset = offsets[jj],
+                              .first_node = first_node + jj * chunk_size,
+                              .num_nodes = std::min(chunk_size, nodes_in_block - jj * chunk_size),
+                              .num_parametric = num_parametric});
+        }
+    }
 
-            for (Integer ii = 0; ii < num_entity_blocks; ++ii) {
-                Integer entity_dim = 0;
-                Integer entity_tag = 0;
-                Integer element_type = 0;
-                Integer elements_in_block = 0;
-                {
-                    std::getline(in, line);
-                    std::stringstream ss(line);
-                    ss >> entity_dim >> entity_tag >> element_type >> elements_in_block;
-                }
+    pool.ParallelFor(0, static_cast<Integer>(chunks.size()), 1, [&](Integer begin, Integer end, Integer /*thread*/) {
+        for (auto ii = begin; ii < end; ++ii) {
+            const auto &chunk = chunks[static_cast<size_t>(ii)];
 
-                for (Integer jj = 0; jj < elements_in_block; ++jj) {
-                    std::getline(in, line);
-
-                    if (element_type == 1) {
-                        // 2-node line
-
-                        Integer element_tag = 0;
-                        Integer ind1 = 0;
-                        Integer ind2 = 0;
-
-                        std::stringstream ss(line);
-                        ss >> element_tag >> ind1 >> ind2;
-
-                        std::array<Integer, 2> node_indices = {ind1 - 1, ind2 - 1};
-
-                        constexpr auto dimension = 1; // 1d
-                        _entities[entity_tag][static_cast<size_t>(dimension)].push_back(
-                            static_cast<Integer>(_elements[static_cast<size_t>(dimension)].size()));
-                        _elements[static_cast<size_t>(dimension)].push_back(
-                            std::make_shared<Line>(node_indices, _nodes));
-                    } else if (element_type == 2) {
-                        // 3-node triangle
-
-                        Integer element_tag = 0;
-                        Integer ind1 = 0;
-                        Integer ind2 = 0;
-                        Integer ind3 = 0;
-
-                        std::stringstream ss(line);
-                        ss >> element_tag >> ind1 >> ind2 >> ind3;
-
-                        std::array<Integer, 3> node_indices = {ind1 - 1, ind2 - 1, ind3 - 1};
-
-                        constexpr auto dimension = 2; // 2d
-                        _entities[entity_tag][static_cast<size_t>(dimension)].push_back(
-                            static_cast<Integer>(_elements[static_cast<size_t>(dimension)].size()));
-                        _elements[static_cast<size_t>(dimension)].push_back(
-                            std::make_shared<Triangle>(node_indices, _nodes));
-                    } else if (element_type == 4) {
-                        // 4-node tetrahedron
-
-                        Integer element_tag = 0;
-                        Integer ind1 = 0;
-                        Integer ind2 = 0;
-                        Integer ind3 = 0;
-                        Integer ind4 = 0;
-
-                        std::stringstream ss(line);
-                        ss >> element_tag >> ind1 >> ind2 >> ind3 >> ind4;
-
-                        std::array<Integer, 4> node_indices = {ind1 - 1, ind2 - 1, ind3 - 1, ind4 - 1};
-
-                        constexpr auto dimension = 3; // 3d
-                        _entities[entity_tag][static_cast<size_t>(dimension)].push_back(
-                            static_cast<Integer>(_elements[static_cast<size_t>(dimension)].size()));
-                        _elements[static_cast<size_t>(dimension)].push_back(
-                            std::make_shared<Tetrahedron>(node_indices, _nodes));
-                    } else if (element_type == 8) {
-                        // 3-node line
-
-                        Integer element_tag = 0;
-                        Integer ind1 = 0;
-                        Integer ind2 = 0;
-                        Integer ind3 = 0;
-
-                        std::stringstream ss(line);
-                        ss >> element_tag >> ind1 >> ind2 >> ind3;
-
-                        std::array<Integer, 3> node_indices = {ind1 - 1, ind2 - 1, ind3 - 1};
-
-                        constexpr auto dimension = 1; // 1d
-                        _entities[entity_tag][static_cast<size_t>(dimension)].push_back(
-                            static_cast<Integer>(_elements[static_cast<size_t>(dimension)].size()));
-                        _elements[static_cast<size_t>(dimension)].push_back(
-                            std::make_shared<LineOrder2>(node_indices, _nodes));
-                    } else if (element_type == 9) {
-                        // 6-node triangle
-
-                        Integer element_tag = 0;
-                        Integer ind1 = 0;
-                        Integer ind2 = 0;
-                        Integer ind3 = 0;
-                        Integer ind4 = 0;
-                        Integer ind5 = 0;
-                        Integer ind6 = 0;
-
-                        std::stringstream ss(line);
-                        ss >> element_tag >> ind1 >> ind2 >> ind3 >> ind4 >> ind5 >> ind6;
-
-                        std::array<Integer, 6> node_indices = {ind1 - 1, ind2 - 1, ind3 - 1,
-                                                               ind4 - 1, ind5 - 1, ind6 - 1};
-
-                        constexpr auto dimension = 2; // 2d
-                        _entities[entity_tag][static_cast<size_t>(dimension)].push_back(
-                            static_cast<Integer>(_elements[static_cast<size_t>(dimension)].size()));
-                        _elements[static_cast<size_t>(dimension)].push_back(
-                            std::make_shared<TriangleOrder2>(node_indices, _nodes));
-
-                        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
-                    } else if (element_type == 11) {
-                        // 10-node tetrahedron
-
-                        Integer element_tag = 0;
-                        Integer ind1 = 0;
-                        Integer ind2 = 0;
-                        Integer ind3 = 0;
-                        Integer ind4 = 0;
-                        Integer ind5 = 0;
-                        Integer ind6 = 0;
-                        Integer ind7 = 0;
-                        Integer ind8 = 0;
-                        Integer ind9 = 0;
-                        Integer ind10 = 0;
-
-                        std::stringstream ss(line);
-                        ss >> element_tag >> ind1 >> ind2 >> ind3 >> ind4 >> ind5 >> ind6 >> ind7 >> ind8 >> ind9 >>
-                            ind10;
-
-                        std::array<Integer, 10> node_indices = {ind1 - 1, ind2 - 1, ind3 - 1, ind4 - 1, ind5 - 1,
-                                                                ind6 - 1, ind7 - 1, ind8 - 1, ind9 - 1, ind10 - 1};
-
-                        constexpr auto dimension = 3; // 3d
-                        _entities[entity_tag][static_cast<size_t>(dimension)].push_back(
-                            static_cast<Integer>(_elements[static_cast<size_t>(dimension)].size()));
-                        _elements[static_cast<size_t>(dimension)].push_back(
-                            std::make_shared<TetrahedronOrder2>(node_indices, _nodes));
-                    }
+            auto chunk_in = in;
+            chunk_in.Seek(chunk.offset);
+
+            auto coords = std::span<Coord>(_nodes).subspan(chunk.first_node, chunk.num_nodes);
+            if (chunk.num_parametric == 0) {
+                chunk_in.ReadCoords(coords);
+                continue;
+            }
+
+            for (size_t jj = 0; jj < coords.size(); ++jj) {
+                chunk_in.ReadCoords(coords.subspan(jj, 1));
+                for (Integer kk = 0; kk < chunk.num_parametric; ++kk) {
+                    chunk_in.ReadFloat();
                 }
             }
         }
-    }
+    });
+}
+
+void Mesh::ReadElements(GmshReader &in, ThreadPool &pool, size_t chunk_size) {
+    const auto num_entity_blocks = in.ReadSize();
+    in.SkipSizes(3); // number of elements, min and max element tags
+
+    // Like the nodes, the elements are located here and then parsed in parallel chunks of at most chunk_size elements:
+    struct Chunk {
+        size_t offset;
+        Integer dimension;
+        size_t block;
+        size_t first_element; // in the block
+        size_t num_elements;
+    };
+
+    std::vector<Chunk> chunks;
+
+    for (size_t ii = 0; ii < num_entity_blocks; ++ii) {
+        in.ReadInt(); // entity dimension
+        const auto entity_tag = in.ReadInt();
+        const auto element_type = in.ReadInt();
+        const auto elements_in_block = in.ReadSize();
+
+        // Every element is its tag followed by its node tags:
+        const auto num_nodes = GmshElementNumNodes(element_type);
+        Check(num_nodes > 0, "Unknown Gmsh element type: {}", element_type);
+        const auto record_bytes = (static_cast<size_t>(num_nodes) + 1) * in.SizeWidth();
+
+        // Unsupported element types (e.g. points) are skipped:
+        const auto dimension = GmshElementDimension(element_type);
+        if (dimension < 0) {
+            in.SkipRecords(elements_in_block, record_bytes, std::max<size_t>(elements_in_block, 1));
+            continue;
+        }
 
-    Log::Info("Num nodes read = {}", _nodes->size());
-    for (size_t ii = 0; ii < 4; ++ii) {
-        Log::Info("Num elements read = {} (dimension {})", _elements.at(ii).size(), ii);
+        // Following entity blocks of the same element type are merged into one element block:
+        const auto vtk_cell_type = GmshElementVTKCellType(element_type);
+        auto &blocks = _elementBlocks[static_cast<size_t>(dimension)];
+        if (blocks.empty() || blocks.back().vtk_cell_type != vtk_cell_type) {
+            blocks.push_back({.vtk_cell_type = vtk_cell_type,
+                              .nodes_per_element = num_nodes,
+                              .first_element = GetNumElements(dimension),
+                              .node_indices = {}});
+        }
+
+        auto &block = blocks.back();
+        const auto first_element = static_cast<size_t>(block.NumElements());
+        ReserveMore(block.node_indices, elements_in_block * static_cast<size_t>(num_nodes));
+        block.node_indices.resize((first_element + elements_in_block) * static_cast<size_t>(num_nodes));
+
+        auto &entity_elements = _entities[entity_tag][static_cast<size_t>(dimension)];
+        ReserveMore(entity_elements, elements_in_block);
+        for (size_t jj = 0; jj < elements_in_block; ++jj) {
+            entity_elements.push_back(block.first_element + static_cast<Integer>(first_element + jj));
+        }
+
+        const auto offsets = in.SkipRecords(elements_in_block, record_bytes, chunk_size);
+        for (size_t jj = 0; jj < offsets.size(); ++jj) {
+            chunks.push_back({.offset = offsets[jj],
+                              .dimension = dimension,
+                              .block = blocks.size() - 1,
+                              .first_element = first_element + jj * chunk_size,
+                              .num_elements = std::min(chunk_size, elements_in_block - jj * chunk_size)});
+        }
     }
 
-    in.close();
+    // Element tag followed by the node tags of every element of a chunk, for every thread:
+    std::vector<std::vector<uint64_t>> thread_tags(static_cast<size_t>(pool.NumThreads()));
+
+    pool.ParallelFor(0, static_cast<Integer>(chunks.size()), 1, [&](Integer begin, Integer end, Integer thread) {
+        auto &tags = thread_tags[static_cast<size_t>(thread)];
+
+        for (auto ii = begin; ii < end; ++ii) {
+            const auto &chunk = chunks[static_cast<size_t>(ii)];
+            auto &block = _elementBlocks[static_cast<size_t>(chunk.dimension)][chunk.block];
+            const auto num_nodes = static_cast<size_t>(block.nodes_per_element);
+            const auto stride = num_nodes + 1;
+
+            auto chunk_in = in;
+            chunk_in.Seek(chunk.offset);
+
+            tags.resize(chunk.num_elements * stride);
+            chunk_in.ReadSizes(tags);
+
+            auto node_indices = std::span<Integer>(block.node_indices)
+                                    .subspan(chunk.first_element * num_nodes, chunk.num_elements * num_nodes);
+            for (size_t jj = 0; jj < chunk.num_elements; ++jj) {
+                // Node tags are one based:
+                for (size_t kk = 0; kk < num_nodes; ++kk) {
+                    node_indices[jj * num_nodes + kk] = static_cast<Integer>(tags[jj * stride + kk + 1]) - 1;
+                }
+            }
+        }
+    });
 }
 
 void Mesh::WriteVTK(const std::filesystem::path &filename) const {
+    // Everything is written in the order of the Gmsh file, whatever the mesh was reordered to:
+    const auto nodes = CurrentIndices(_originalNodes, _nodes.size());
+
     std::ofstream out(filename);
 
     constexpr auto float_precision = 16;
@@ -353,67 +344,68 @@ void Mesh::WriteVTK(const std::filesystem::path &filename) const {
     out << "ASCII" << std::endl;
 
     out << "DATASET UNSTRUCTURED_GRID" << std::endl;
-    out << "POINTS " << _nodes->size() << " double" << std::endl;
-    for (size_t ii = 0; ii < _nodes->size(); ++ii) {
-        out << std::setprecision(float_precision) << (*_nodes)[ii].x << " ";
-        out << std::setprecision(float_precision) << (*_nodes)[ii].y << " ";
-        out << std::setprecision(float_precision) << (*_nodes)[ii].z << std::endl;
+    out << "POINTS " << _nodes.size() << " double" << std::endl;
+    for (const auto &node : nodes) {
+        const auto &coord = _nodes[static_cast<size_t>(node)];
+        out << std::setprecision(float_precision) << coord.x << " ";
+        out << std::setprecision(float_precision) << coord.y << " ";
+        out << std::setprecision(float_precision) << coord.z << std::endl;
     }
     out << std::endl;
 
     Integer size_of_elements = 0;
     Integer num_elements = 0;
-    for (const auto &elements : _elements) {
-        for (const auto &element : elements) {
-            size_of_elements += element->NumNodes() + 1;
-            num_elements++;
+    for (const auto &blocks : _elementBlocks) {
+        for (const auto &block : blocks) {
+            size_of_elements += block.NumElements() * (block.nodes_per_element + 1);
+            num_elements += block.NumElements();
         }
     }
 
     out << "CELLS " << num_elements << " " << size_of_elements << std::endl;
-    for (const auto &elements : _elements) {
-        for (const auto &element : elements) {
-            out << element->NumNodes();
-
-            for (Integer jj = 0; jj < element->NumNodes(); ++jj) {
-
-                // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
-                if (element->VTKCellType() == 24 && jj == 8) {
-                    out << " " << element->GetNodeIndex(9);
-                }
-                // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
-                else if (element->VTKCellType() == 24 && jj == 9) {
-                    out << " " << element->GetNodeIndex(8);
-                } else {
-                    out << " " << element->GetNodeIndex(jj);
+    for (size_t dimension = 0; dimension < _elementBlocks.size(); ++dimension) {
+        const auto elements = CurrentIndices(_originalElements[dimension],
+                                             static_cast<size_t>(GetNumElements(static_cast<Integer>(dimension))));
+        for (const auto &block : _elementBlocks[dimension]) {
+            // Reordering only moves elements within their block:
+            for (Integer ii = 0; ii < block.NumElements(); ++ii) {
+                const auto element_id = elements[static_cast<size_t>(block.first_element + ii)];
+                const auto element_nodes = block.ElementNodes(element_id - block.first_element);
+                out << element_nodes.size();
+
+                for (size_t jj = 0; jj < element_nodes.size(); ++jj) {
+                    out << " " << GetOriginalNodeIndex(VTKNodeIndex(block.vtk_cell_type, element_nodes, jj));
                 }
+                out << std::endl;
             }
-            out << std::endl;
         }
     }
     out << std::endl;
 
     out << "CELL_TYPES " << num_elements << std::endl;
-    for (const auto &elements : _elements) {
-        for (const auto &element : elements) {
-            out << element->VTKCellType() << std::endl;
+    for (const auto &blocks : _elementBlocks) {
+        for (const auto &block : blocks) {
+            for (Integer ii = 0; ii < block.NumElements(); ++ii) {
+                out << block.vtk_cell_type << std::endl;
+            }
         }
     }
     out << std::endl;
 
-    out << "POINT_DATA " << _nodes->size() << std::endl;
+    out << "POINT_DATA " << _nodes.size() << std::endl;
     for (const auto &[data_name, values] : _scalarFields) {
         out << "SCALARS " << data_name << " double" << std::endl;
         out << "LOOKUP_TABLE default" << std::endl;
-        for (const auto &value : values) {
-            out << std::setprecision(float_precision) << value << std::endl;
+        for (const auto &node : nodes) {
+            out << std::setprecision(float_precision) << values[static_cast<size_t>(node)] << std::endl;
         }
         out << std::endl;
     }
 
     for (const auto &[data_name, values] : _vectorFields) {
         out << "VECTORS " << data_name << " double" << std::endl;
-        for (const auto &value : values) {
+        for (const auto &node : nodes) {
+            const auto &value = values[static_cast<size_t>(node)];
             out << std::setprecision(float_precision) << value[0] << " " << value[1] << " " << value[2] << std::endl;
         }
         out << std::endl;
@@ -421,7 +413,8 @@ void Mesh::WriteVTK(const std::filesystem::path &filename) const {
 
     for (const auto &[data_name, values] : _tensorFields) {
         out << "TENSORS " << data_name << " double" << std::endl;
-        for (const auto &value : values) {
+        for (const auto &node : nodes) {
+            const auto &value = values[static_cast<size_t>(node)];
             out << std::setprecision(float_precision) << value[0] << " " << value[3] << " " << value[5] << std::endl;
             out << std::setprecision(float_precision) << value[3] << " " << value[1] << " " << value[4] << std::endl;
             out << std::setprecision(float_precision) << value[5] << " " << value[4] << " " << value[2] << std::endl;
@@ -433,16 +426,74 @@ void Mesh::WriteVTK(const std::filesystem::path &filename) const {
     out.close();
 }
 
+void Mesh::WriteVTK(const std::filesystem::path &filename, Integer dimension,
+                    std::span<const Integer> element_ids) const {
+    // Number the nodes used by the elements in the order they are first seen:
+    std::vector<Integer> node_map(_nodes.size(), -1);
+    std::vector<Integer> nodes;
+    Integer size_of_elements = 0;
+    for (const auto &element_id : element_ids) {
+        const auto element_nodes = GetElementNodes(dimension, element_id);
+        size_of_elements += static_cast<Integer>(element_nodes.size()) + 1;
+
+        for (const auto &node : element_nodes) {
+            auto &mapped_node = node_map[static_cast<size_t>(node)];
+            if (mapped_node < 0) {
+                mapped_node = static_cast<Integer>(nodes.size());
+                nodes.push_back(node);
+            }
+        }
+    }
+
+    std::ofstream out(filename);
+
+    constexpr auto float_precision = 16;
+
+    out << "# vtk DataFile Version 2.0" << std::endl;
+    out << "Generated by Plasmatic" << std::endl;
+    out << "ASCII" << std::endl;
+
+    out << "DATASET UNSTRUCTURED_GRID" << std::endl;
+    out << "POINTS " << nodes.size() << " double" << std::endl;
+    for (const auto &node : nodes) {
+        const auto &coord = _nodes[static_cast<size_t>(node)];
+        out << std::setprecision(float_precision) << coord.x << " ";
+        out << std::setprecision(float_precision) << coord.y << " ";
+        out << std::setprecision(float_precision) << coord.z << std::endl;
+    }
+    out << std::endl;
+
+    out << "CELLS " << element_ids.size() << " " << size_of_elements << std::endl;
+    for (const auto &element_id : element_ids) {
+        const auto &block = FindElementBlock(dimension, element_id);
+        const auto element_nodes = block.ElementNodes(element_id - block.first_element);
+        out << element_nodes.size();
+
+        for (size_t jj = 0; jj < element_nodes.size(); ++jj) {
+            out << " " << node_map[static_cast<size_t>(VTKNodeIndex(block.vtk_cell_type, element_nodes, jj))];
+        }
+        out << std::endl;
+    }
+    out << std::endl;
+
+    out << "CELL_TYPES " << element_ids.size() << std::endl;
+    for (const auto &element_id : element_ids) {
+        out << FindElementBlock(dimension, element_id).vtk_cell_type << std::endl;
+    }
+
+    out.close();
+}
+
 void Mesh::AddScalarField(const std::string &field_name) {
-    _scalarFields.insert({field_name, std::vector<Float>(_nodes->size())});
+    _scalarFields.insert({field_name, std::vector<Float>(_nodes.size())});
 }
 
 void Mesh::AddVectorField(const std::string &field_name) {
-    _vectorFields.insert({field_name, std::vector<std::array<Float, 3>>(_nodes->size())});
+    _vectorFields.insert({field_name, std::vector<std::array<Float, 3>>(_nodes.size())});
 }
 
 void Mesh::AddTensorField(const std::string &field_name) {
-    _tensorFields.insert({field_name, std::vector<std::array<Float, 6>>(_nodes->size())});
+    _tensorFields.insert({field_name, std::vector<std::array<Float, 6>>(_nodes.size())});
 }
 
 void Mesh::ScalarFieldSetValue(const std::string &field_name, Integer index, Float value) {
@@ -460,8 +511,10 @@ void Mesh::TensorFieldSetValue(const std::string &field_name, Integer index, std
 void Mesh::WriteSurfaceMesh(const std::filesystem::path &base_filename) const {
     constexpr auto dimension = 2; // 2d
 
+    // Like WriteVTK, in the node order of the Gmsh file:
     std::ofstream out_vert(base_filename.string() + "_verts.csv");
-    for (const auto &coord : *_nodes) {
+    for (const auto &node : CurrentIndices(_originalNodes, _nodes.size())) {
+        const auto &coord = _nodes[static_cast<size_t>(node)];
         // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
         out_vert << std::setprecision(16) << coord.x << "," << coord.y << "," << coord.z << std::endl;
     }
@@ -472,12 +525,20 @@ void Mesh::WriteSurfaceMesh(const std::filesystem::path &base_filename) const {
             continue;
         }
 
+        auto element_ids = value[dimension];
+        const auto &original_elements = _originalElements[dimension];
+        if (!original_elements.empty()) {
+            std::sort(element_ids.begin(), element_ids.end(), [&](Integer lhs, Integer rhs) {
+                return original_elements[static_cast<size_t>(lhs)] < original_elements[static_cast<size_t>(rhs)];
+            });
+        }
+
         std::ofstream out_tri(base_filename.string() + "_" + std::to_string(key) + "_tris.csv");
-        for (auto element_id : value[dimension]) {
-            auto element = this->GetElement(dimension, element_id);
+        for (auto element_id : element_ids) {
+            const auto element_nodes = GetElementNodes(dimension, element_id);
 
-            for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
-                auto node_index = element->GetNodeIndex(ii);
+            for (size_t ii = 0; ii < element_nodes.size(); ++ii) {
+                auto node_index = GetOriginalNodeIndex(element_nodes[ii]);
 
                 if (ii != 0) {
                     out_tri << ",";
@@ -490,4 +551,40 @@ void Mesh::WriteSurfaceMesh(const std::filesystem::path &base_filename) const {
     }
 }
 
+std::vector<std::vector<Integer>> Mesh::ColorElements(Integer dimension) const {
+    const auto num_elements = static_cast<size_t>(GetNumElements(dimension));
+    const auto &node_elements = GetNodeElements(dimension);
+
+    // Give every element the lowest color that none of its (already colored) neighbors has. `forbidden[color]` holds
+    // the last element that saw the color on a neighbor, which avoids clearing it for every element:
+    std::vector<Integer> element_colors(num_elements, -1);
+    std::vector<Integer> forbidden;
+    std::vector<std::vector<Integer>> colors;
+    for (size_t element_id = 0; element_id < num_elements; ++element_id) {
+        for (const auto &node : GetElementNodes(dimension, static_cast<Integer>(element_id))) {
+            for (const auto &neighbor : node_elements.Neighbors(node)) {
+                auto neighbor_color = element_colors[static_cast<size_t>(neighbor)];
+                if (neighbor_color >= 0) {
+                    forbidden[static_cast<size_t>(neighbor_color)] = static_cast<Integer>(element_id);
+                }
+            }
+        }
+
+        size_t color = 0;
+        while (color < forbidden.size() && forbidden[color] == static_cast<Integer>(element_id)) {
+            ++color;
+        }
+
+        if (color == colors.size()) {
+            colors.emplace_back();
+            forbidden.push_back(-1);
+        }
+
+        element_colors[element_id] = static_cast<Integer>(color);
+        colors[color].push_back(static_cast<Integer>(element_id));
+    }
+
+    return colors;
+}
+
 } // namespace plasmatic
@@ -0,0 +1,199 @@
+#include "interface/Mesh/Mesh.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+
+namespace plasmatic {
+
+namespace {
+
+constexpr Integer chunk_size = 4096;
+
+void LogAdjacency(std::string_view name, Integer dimension, const Adjacency &adjacency) {
+    constexpr Float bytes_per_megabyte = 1024.0 * 1024.0;
+    Log::Info("Built {} adjacency of dimension {} ({} entries, {:.1f} MB)", name, dimension, adjacency.neighbors.size(),
+              static_cast<Float>(adjacency.MemoryBytes()) / bytes_per_megabyte);
+}
+
+// Turns counts stored at offsets[ii + 1] into the offsets of a CSR structure:
+void CountsToOffsets(std::vector<Integer> &offsets) {
+    for (size_t ii = 1; ii < offsets.size(); ++ii) {
+        offsets[ii] += offsets[ii - 1];
+    }
+}
+
+} // namespace
+
+const Adjacency &Mesh::GetNodeElements(Integer dimension) const {
+    auto &node_elements = _nodeElements.at(static_cast<size_t>(dimension));
+    if (node_elements) {
+        return *node_elements;
+    }
+
+    const auto num_elements = GetNumElements(dimension);
+    ThreadPool pool(_numThreads);
+
+    // Counting sort of the element ids by node: the first pass counts the elements of every node, the second one
+    // puts every element into the slots of its nodes. Both are done in parallel with atomic counters, so the elements
+    // of a node end up out of order and are sorted at the end.
+    Adjacency adjacency;
+    adjacency.offsets.assign(static_cast<size_t>(GetNumNodes()) + 1, 0);
+    pool.ParallelFor(0, num_elements, chunk_size, [&](Integer begin, Integer end, Integer /*thread_index*/) {
+        for (auto element_id = begin; element_id < end; ++element_id) {
+            for (const auto &node : GetElementNodes(dimension, element_id)) {
+                std::atomic_ref<Integer>(adjacency.offsets[static_cast<size_t>(node) + 1])
+                    .fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    CountsToOffsets(adjacency.offsets);
+
+    adjacency.neighbors.resize(static_cast<size_t>(adjacency.offsets.back()));
+    std::vector<Integer> fill_position(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    pool.ParallelFor(0, num_elements, chunk_size, [&](Integer begin, Integer end, Integer /*thread_index*/) {
+        for (auto element_id = begin; element_id < end; ++element_id) {
+            for (const auto &node : GetElementNodes(dimension, element_id)) {
+                const auto position = std::atomic_ref<Integer>(fill_position[static_cast<size_t>(node)])
+                                          .fetch_add(1, std::memory_order_relaxed);
+                adjacency.neighbors[static_cast<size_t>(position)] = element_id;
+            }
+        }
+    });
+
+    pool.ParallelFor(0, adjacency.NumItems(), chunk_size, [&](Integer begin, Integer end, Integer /*thread_index*/) {
+        for (auto node = begin; node < end; ++node) {
+            std::sort(adjacency.neighbors.begin() + adjacency.offsets[static_cast<size_t>(node)],
+                      adjacency.neighbors.begin() + adjacency.offsets[static_cast<size_t>(node) + 1]);
+        }
+    });
+
+    LogAdjacency("node to element", dimension, adjacency);
+    node_elements = std::move(adjacency);
+
+    return *node_elements;
+}
+
+const Adjacency &Mesh::GetNodeNodes(Integer dimension) const {
+    auto &node_nodes = _nodeNodes.at(static_cast<size_t>(dimension));
+    if (node_nodes) {
+        return *node_nodes;
+    }
+
+    const auto &node_elements = GetNodeElements(dimension);
+    ThreadPool pool(_numThreads);
+
+    // The sorted, unique nodes of the elements of a node (which always include the node itself):
+    std::vector<std::vector<Integer>> thread_nodes(static_cast<size_t>(pool.NumThreads()));
+    const auto collect_nodes = [&](Integer node, Integer thread_index) -> const std::vector<Integer> & {
+        auto &nodes = thread_nodes[static_cast<size_t>(thread_index)];
+        nodes.assign(1, node);
+        for (const auto &element_id : node_elements.Neighbors(node)) {
+            const auto element_nodes = GetElementNodes(dimension, element_id);
+            nodes.insert(nodes.end(), element_nodes.begin(), element_nodes.end());
+        }
+
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+        return nodes;
+    };
+
+    // Like the node to element adjacency, a counting pass and a filling pass (which collects the nodes again rather
+    // than keeping them around):
+    Adjacency adjacency;
+    adjacency.offsets.assign(static_cast<size_t>(GetNumNodes()) + 1, 0);
+    pool.ParallelFor(0, GetNumNodes(), chunk_size, [&](Integer begin, Integer end, Integer thread_index) {
+        for (auto node = begin; node < end; ++node) {
+            adjacency.offsets[static_cast<size_t>(node) + 1] =
+                static_cast<Integer>(collect_nodes(node, thread_index).size());
+        }
+    });
+
+    CountsToOffsets(adjacency.offsets);
+
+    adjacency.neighbors.resize(static_cast<size_t>(adjacency.offsets.back()));
+    pool.ParallelFor(0, GetNumNodes(), chunk_size, [&](Integer begin, Integer end, Integer thread_index) {
+        for (auto node = begin; node < end; ++node) {
+            const auto &nodes = collect_nodes(node, thread_index);
+            std::copy(nodes.begin(), nodes.end(),
+                      adjacency.neighbors.begin() + adjacency.offsets[static_cast<size_t>(node)]);
+        }
+    });
+
+    LogAdjacency("node to node", dimension, adjacency);
+    node_nodes = std::move(adjacency);
+
+    return *node_nodes;
+}
+
+const Adjacency &Mesh::GetElementNeighbors(Integer dimension) const {
+    auto &element_neighbors = _elementNeighbors.at(static_cast<size_t>(dimension));
+    if (element_neighbors) {
+        return *element_neighbors;
+    }
+
+    Check(dimension >= 1, "Elements of dimension {} have no faces", dimension);
+
+    const auto &node_elements = GetNodeElements(dimension);
+    const auto num_elements = GetNumElements(dimension);
+    ThreadPool pool(_numThreads);
+
+    // A simplex of this dimension has dimension + 1 corners (its first nodes) and as many faces, so every element has
+    // the same number of entries:
+    const auto num_corners = static_cast<size_t>(dimension) + 1;
+
+    Adjacency adjacency;
+    adjacency.offsets.resize(static_cast<size_t>(num_elements) + 1);
+    for (size_t ii = 0; ii < adjacency.offsets.size(); ++ii) {
+        adjacency.offsets[ii] = static_cast<Integer>(ii * num_corners);
+    }
+    adjacency.neighbors.assign(static_cast<size_t>(num_elements) * num_corners, -1);
+
+    // The neighbor across a face is the other element that has all corners of the face, i.e. the other element in
+    // the intersection of the (sorted) elements of the corners:
+    std::vector<std::array<std::vector<Integer>, 2>> thread_elements(static_cast<size_t>(pool.NumThreads()));
+
+    pool.ParallelFor(0, num_elements, chunk_size, [&](Integer begin, Integer end, Integer thread_index) {
+        auto &[shared, intersection] = thread_elements[static_cast<size_t>(thread_index)];
+
+        for (auto element_id = begin; element_id < end; ++element_id) {
+            const auto corners = GetElementNodes(dimension, element_id).first(num_corners);
+            for (size_t face = 0; face < num_corners; ++face) {
+                shared.clear();
+                for (size_t ii = 0; ii < num_corners; ++ii) {
+                    if (ii == face) {
+                        continue;
+                    }
+
+                    const auto corner_elements = node_elements.Neighbors(corners[ii]);
+                    if (shared.empty()) {
+                        shared.assign(corner_elements.begin(), corner_elements.end());
+                        continue;
+                    }
+
+                    intersection.clear();
+                    std::set_intersection(shared.begin(), shared.end(), corner_elements.begin(), corner_elements.end(),
+                                          std::back_inserter(intersection));
+                    std::swap(shared, intersection);
+                }
+
+                for (const auto &candidate : shared) {
+                    if (candidate != element_id) {
+                        adjacency.neighbors[static_cast<size_t>(element_id) * num_corners + face] = candidate;
+                        break;
+                    }
+                }
+            }
+        }
+    });
+
+    LogAdjacency("element to element (across faces)", dimension, adjacency);
+    element_neighbors = std::move(adjacency);
+
+    return *element_neighbors;
+}
+
+} // namespace plasmatic
@@ -0,0 +1,263 @@
+#include "interface/Mesh/Mesh.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+namespace plasmatic {
+
+namespace {
+
+// Layout of a cache file (all values in the byte order of the machine that wrote it):
+//   header
+//   nodes:                  array of Coord
+//   for every dimension:    count, then for every element block its VTK cell type, nodes per element and an array of
+//                           the node indices of all its elements
+//   entities:               count, then for every entity its tag and an array of indices for every dimension
+//   physical entities:      count, then for every physical entity its name and an array of tags for every dimension
+//   the magic string again, so that a truncated file is never read
+// Arrays and strings are stored as their size (uint64_t) followed by their values.
+//
+// The version must be bumped whenever the layout changes:
+constexpr std::array<char, 8> cache_magic = {'P', 'L', 'M', 'C', 'A', 'C', 'H', 'E'};
+constexpr uint32_t cache_version = 2;
+constexpr uint32_t byte_order_mark = 0x01020304;
+
+struct CacheHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t byte_order_mark;
+    uint64_t source_size;
+    uint64_t source_checksum;
+};
+
+class CacheWriter {
+  public:
+    CacheWriter(const std::filesystem::path &filename) : _out(filename, std::ios::binary) {}
+
+    // Returns whether everything was written:
+    bool Close() {
+        _out.close();
+        return !_out.fail();
+    }
+
+    template <typename T> void Write(const T &value) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        _out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T> void WriteArray(std::span<const T> values) {
+        Write<uint64_t>(values.size());
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        _out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+    }
+
+    void WriteString(std::string_view value) { WriteArray(std::span<const char>(value.data(), value.size())); }
+
+  private:
+    std::ofstream _out;
+};
+
+// Reads the values of a mapped cache file, copying them out with memcpy. Every read returns false instead of reading
+// past the end of the file:
+class CacheReader {
+  public:
+    CacheReader(std::string_view contents) : _contents(contents) {}
+
+    template <typename T> bool Read(T &value) {
+        if (_position + sizeof(T) > _contents.size()) {
+            return false;
+        }
+
+        std::memcpy(&value, &_contents[_position], sizeof(T));
+        _position += sizeof(T);
+
+        return true;
+    }
+
+    template <typename T> bool ReadArray(std::vector<T> &values) {
+        uint64_t size = 0;
+        if (!Read(size) || size > (_contents.size() - _position) / sizeof(T)) {
+            return false;
+        }
+
+        values.resize(size);
+        std::memcpy(values.data(), &_contents[_position], size * sizeof(T));
+        _position += size * sizeof(T);
+
+        return true;
+    }
+
+    bool ReadString(std::string &value) {
+        std::vector<char> chars;
+        if (!ReadArray(chars)) {
+            return false;
+        }
+
+        value.assign(chars.begin(), chars.end());
+
+        return true;
+    }
+
+  private:
+    std::string_view _contents;
+    size_t _position = 0;
+};
+
+} // namespace
+
+bool Mesh::ReadCache(const std::filesystem::path &filename, size_t source_size, uint64_t source_checksum) {
+    if (!std::filesystem::exists(filename)) {
+        return false;
+    }
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    MappedFile file(filename);
+    CacheReader in(file.Contents());
+
+    CacheHeader header = {};
+    if (!in.Read(header) || header.magic != cache_magic || header.version != cache_version ||
+        header.byte_order_mark != byte_order_mark) {
+        Log::Info("Ignoring mesh cache '{}' written by another version or machine", filename.string());
+        return false;
+    }
+
+    if (header.source_size != source_size || header.source_checksum != source_checksum) {
+        Log::Info("Ignoring mesh cache '{}' since the mesh file changed", filename.string());
+        return false;
+    }
+
+    auto valid = in.ReadArray(_nodes);
+
+    for (size_t dimension = 0; dimension < _elementBlocks.size() && valid; ++dimension) {
+        uint64_t num_blocks = 0;
+        valid = in.Read(num_blocks);
+        for (uint64_t ii = 0; ii < num_blocks && valid; ++ii) {
+            ElementBlock block = {.vtk_cell_type = 0,
+                                  .nodes_per_element = 0,
+                                  .first_element = GetNumElements(static_cast<Integer>(dimension)),
+                                  .node_indices = {}};
+            valid =
+                in.Read(block.vtk_cell_type) && in.Read(block.nodes_per_element) && in.ReadArray(block.node_indices);
+
+            valid = valid && block.nodes_per_element > 0 &&
+                    VTKCellTypeNumNodes(block.vtk_cell_type) == block.nodes_per_element &&
+                    block.node_indices.size() % static_cast<size_t>(block.nodes_per_element) == 0 &&
+                    std::all_of(block.node_indices.begin(), block.node_indices.end(),
+                                [this](Integer index) { return index >= 0 && index < GetNumNodes(); });
+            if (valid) {
+                _elementBlocks[dimension].push_back(std::move(block));
+            }
+        }
+    }
+
+    uint64_t num_entities = 0;
+    valid = valid && in.Read(num_entities);
+    for (uint64_t ii = 0; ii < num_entities && valid; ++ii) {
+        Integer entity_tag = 0;
+        valid = in.Read(entity_tag);
+        for (auto &indices : _entities[entity_tag]) {
+            valid = valid && in.ReadArray(indices);
+        }
+    }
+
+    uint64_t num_physical_entities = 0;
+    valid = valid && in.Read(num_physical_entities);
+    for (uint64_t ii = 0; ii < num_physical_entities && valid; ++ii) {
+        std::string name;
+        valid = in.ReadString(name);
+        for (auto &tags : _physicalEntities[name]) {
+            valid = valid && in.ReadArray(tags);
+        }
+    }
+
+    std::array<char, 8> trailer = {};
+    valid = valid && in.Read(trailer) && trailer == cache_magic;
+
+    if (!valid) {
+        Log::Warn("Ignoring corrupt mesh cache '{}'", filename.string());
+
+        _nodes.clear();
+        for (auto &blocks : _elementBlocks) {
+            blocks.clear();
+        }
+        _entities.clear();
+        _physicalEntities.clear();
+
+        return false;
+    }
+
+    const auto seconds = std::chrono::duration<Float>(std::chrono::steady_clock::now() - start_time).count();
+    Log::Info("Read mesh cache '{}' in {:.3f} s", filename.string(), seconds);
+
+    return true;
+}
+
+void Mesh::WriteCache(const std::filesystem::path &filename, size_t source_size, uint64_t source_checksum) const {
+    // Written to a temporary file that replaces the cache at the end, so that concurrent runs (e.g. several MPI ranks)
+    // never see a partially written cache:
+    std::random_device random;
+    auto temporary_filename = filename;
+    temporary_filename += "." + std::to_string(random()) + ".tmp";
+
+    bool written = false;
+    {
+        CacheWriter out(temporary_filename);
+
+        out.Write(CacheHeader{.magic = cache_magic,
+                              .version = cache_version,
+                              .byte_order_mark = byte_order_mark,
+                              .source_size = source_size,
+                              .source_checksum = source_checksum});
+
+        out.WriteArray(std::span<const Coord>(_nodes));
+
+        for (const auto &blocks : _elementBlocks) {
+            out.Write<uint64_t>(blocks.size());
+            for (const auto &block : blocks) {
+                out.Write(block.vtk_cell_type);
+                out.Write(block.nodes_per_element);
+                out.WriteArray(std::span<const Integer>(block.node_indices));
+            }
+        }
+
+        out.Write<uint64_t>(_entities.size());
+        for (const auto &[entity_tag, indices] : _entities) {
+            out.Write(entity_tag);
+            for (const auto &dimension_indices : indices) {
+                out.WriteArray(std::span<const Integer>(dimension_indices));
+            }
+        }
+
+        out.Write<uint64_t>(_physicalEntities.size());
+        for (const auto &[name, tags] : _physicalEntities) {
+            out.WriteString(name);
+            for (const auto &dimension_tags : tags) {
+                out.WriteArray(std::span<const Integer>(dimension_tags));
+            }
+        }
+
+        out.Write(cache_magic);
+
+        written = out.Close();
+    }
+
+    // Not being able to write the cache (e.g. in a read only directory) only costs the next run some time:
+    std::error_code error;
+    if (written) {
+        std::filesystem::rename(temporary_filename, filename, error);
+    }
+
+    if (!written || error) {
+        Log::Warn("Could not write mesh cache '{}'", filename.string());
+        std::filesystem::remove(temporary_filename, error);
+        return;
+    }
+
+    Log::Info("Wrote mesh cache '{}'", filename.string());
+}
+
+} // namespace plasmatic
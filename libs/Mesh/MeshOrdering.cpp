@@ -0,0 +1,311 @@
+#include "interface/Mesh/Mesh.h"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
+namespace plasmatic {
+
+namespace {
+
+// new_values[ii] = values[order[ii]]:
+template <typename T> std::vector<T> Permute(const std::vector<T> &values, std::span<const Integer> order) {
+    std::vector<T> new_values(values.size());
+    for (size_t ii = 0; ii < order.size(); ++ii) {
+        new_values[ii] = values[static_cast<size_t>(order[ii])];
+    }
+
+    return new_values;
+}
+
+std::vector<Integer> Inverse(std::span<const Integer> order) {
+    std::vector<Integer> inverse(order.size());
+    for (size_t ii = 0; ii < order.size(); ++ii) {
+        inverse[static_cast<size_t>(order[ii])] = static_cast<Integer>(ii);
+    }
+
+    return inverse;
+}
+
+// Composes a new order with the original indices kept so far (none if the mesh wasn't reordered before):
+std::vector<Integer> OriginalIndices(const std::vector<Integer> &original, std::span<const Integer> order) {
+    if (original.empty()) {
+        return {order.begin(), order.end()};
+    }
+
+    return Permute(original, order);
+}
+
+void Renumber(std::vector<Integer> &indices, std::span<const Integer> new_index) {
+    for (auto &index : indices) {
+        index = new_index[static_cast<size_t>(index)];
+    }
+}
+
+// Reverse Cuthill-McKee ordering of a graph whose adjacency includes every item itself. Returns the old index of every
+// new index.
+std::vector<Integer> ReverseCuthillMcKee(const Adjacency &graph) {
+    const auto num_nodes = static_cast<size_t>(graph.NumItems());
+    const auto degree = [&](Integer node) { return graph.Neighbors(node).size(); };
+
+    // Breadth first search through the nodes that aren't numbered yet, leaving the visited nodes in `queue` and their
+    // distance from the root in `level`. Returns the largest distance, which the caller resets `level` after:
+    std::vector<bool> numbered(num_nodes, false);
+    std::vector<Integer> level(num_nodes, -1);
+    std::vector<Integer> queue;
+    const auto breadth_first = [&](Integer root) {
+        queue.assign(1, root);
+        level[static_cast<size_t>(root)] = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const auto node = queue[head];
+            for (const auto &neighbor : graph.Neighbors(node)) {
+                if (!numbered[static_cast<size_t>(neighbor)] && level[static_cast<size_t>(neighbor)] < 0) {
+                    level[static_cast<size_t>(neighbor)] = level[static_cast<size_t>(node)] + 1;
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+
+        return level[static_cast<size_t>(queue.back())];
+    };
+
+    const auto reset_levels = [&]() {
+        for (const auto &node : queue) {
+            level[static_cast<size_t>(node)] = -1;
+        }
+    };
+
+    std::vector<Integer> order;
+    order.reserve(num_nodes);
+    std::vector<Integer> neighbors;
+    for (Integer start = 0; start < static_cast<Integer>(num_nodes); ++start) {
+        if (numbered[static_cast<size_t>(start)]) {
+            continue;
+        }
+
+        // Start every connected part of the graph from a pseudo-peripheral node (George and Liu): move to the node of
+        // lowest degree among the farthest ones for as long as that makes the search deeper.
+        auto root = start;
+        auto depth = breadth_first(root);
+        while (true) {
+            auto candidate = queue.back();
+            for (auto ii = queue.rbegin(); ii != queue.rend() && level[static_cast<size_t>(*ii)] == depth; ++ii) {
+                if (degree(*ii) < degree(candidate)) {
+                    candidate = *ii;
+                }
+            }
+            reset_levels();
+
+            const auto candidate_depth = breadth_first(candidate);
+            if (candidate_depth <= depth) {
+                reset_levels();
+                break;
+            }
+
+            root = candidate;
+            depth = candidate_depth;
+        }
+
+        // Cuthill-McKee: number the nodes breadth first, the neighbors of every node by increasing degree:
+        numbered[static_cast<size_t>(root)] = true;
+        order.push_back(root);
+        for (auto head = order.size() - 1; head < order.size(); ++head) {
+            neighbors.clear();
+            for (const auto &neighbor : graph.Neighbors(order[head])) {
+                if (!numbered[static_cast<size_t>(neighbor)]) {
+                    numbered[static_cast<size_t>(neighbor)] = true;
+                    neighbors.push_back(neighbor);
+                }
+            }
+
+            std::stable_sort(neighbors.begin(), neighbors.end(),
+                             [&](Integer lhs, Integer rhs) { return degree(lhs) < degree(rhs); });
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+
+    return order;
+}
+
+// Position along a Hilbert curve of a point with coordinates of `hilbert_bits` bits each (Skilling, "Programming the
+// Hilbert curve", 2004):
+constexpr Integer hilbert_bits = 21;
+
+uint64_t HilbertIndex(std::array<uint32_t, 3> axes) {
+    // Inverse undo:
+    for (uint32_t qq = 1U << (hilbert_bits - 1); qq > 1; qq >>= 1U) {
+        const auto pp = qq - 1;
+        for (auto &axis : axes) {
+            if ((axis & qq) != 0) {
+                axes[0] ^= pp;
+            } else {
+                const auto tt = (axes[0] ^ axis) & pp;
+                axes[0] ^= tt;
+                axis ^= tt;
+            }
+        }
+    }
+
+    // Gray encode:
+    for (size_t ii = 1; ii < axes.size(); ++ii) {
+        axes[ii] ^= axes[ii - 1];
+    }
+
+    uint32_t tt = 0;
+    for (uint32_t qq = 1U << (hilbert_bits - 1); qq > 1; qq >>= 1U) {
+        if ((axes.back() & qq) != 0) {
+            tt ^= qq - 1;
+        }
+    }
+
+    // Interleave the bits of the transposed index, most significant first:
+    uint64_t index = 0;
+    for (auto bit = hilbert_bits - 1; bit >= 0; --bit) {
+        for (const auto &axis : axes) {
+            index = (index << 1U) | (((axis ^ tt) >> static_cast<uint32_t>(bit)) & 1U);
+        }
+    }
+
+    return index;
+}
+
+// Returns the old index of every new index, sorting the nodes along a Hilbert curve through their bounding box:
+std::vector<Integer> HilbertOrder(std::span<const Coord> nodes, ThreadPool &pool) {
+    Coord lower = {.x = std::numeric_limits<Float>::max(),
+                   .y = std::numeric_limits<Float>::max(),
+                   .z = std::numeric_limits<Float>::max()};
+    Coord upper = {.x = std::numeric_limits<Float>::lowest(),
+                   .y = std::numeric_limits<Float>::lowest(),
+                   .z = std::numeric_limits<Float>::lowest()};
+    for (const auto &node : nodes) {
+        lower = {.x = std::min(lower.x, node.x), .y = std::min(lower.y, node.y), .z = std::min(lower.z, node.z)};
+        upper = {.x = std::max(upper.x, node.x), .y = std::max(upper.y, node.y), .z = std::max(upper.z, node.z)};
+    }
+
+    // The same scale on every axis, so the curve doesn't stretch with the aspect ratio of the mesh:
+    const auto extent = std::max({upper.x - lower.x, upper.y - lower.y, upper.z - lower.z});
+    const auto scale = extent > 0.0 ? static_cast<Float>((1U << hilbert_bits) - 1) / extent : 0.0;
+    const auto quantize = [&](Float value, Float min) { return static_cast<uint32_t>((value - min) * scale); };
+
+    std::vector<uint64_t> keys(nodes.size());
+    constexpr Integer chunk_size = 4096;
+    pool.ParallelFor(0, static_cast<Integer>(nodes.size()), chunk_size, [&](Integer begin, Integer end, Integer) {
+        for (auto ii = static_cast<size_t>(begin); ii < static_cast<size_t>(end); ++ii) {
+            const auto &node = nodes[ii];
+            keys[ii] = HilbertIndex({quantize(node.x, lower.x), quantize(node.y, lower.y), quantize(node.z, lower.z)});
+        }
+    });
+
+    std::vector<Integer> order(nodes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](Integer lhs, Integer rhs) {
+        return keys[static_cast<size_t>(lhs)] < keys[static_cast<size_t>(rhs)];
+    });
+
+    return order;
+}
+
+} // namespace
+
+Integer Mesh::GetBandwidth(Integer dimension) const {
+    Integer bandwidth = 0;
+    for (const auto &block : GetElementBlocks(dimension)) {
+        for (Integer ii = 0; ii < block.NumElements(); ++ii) {
+            const auto [min, max] = std::minmax_element(block.ElementNodes(ii).begin(), block.ElementNodes(ii).end());
+            bandwidth = std::max(bandwidth, *max - *min);
+        }
+    }
+
+    return bandwidth;
+}
+
+void Mesh::Reorder(NodeOrdering ordering) {
+    if (ordering == NodeOrdering::Original) {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // The node graph (and the bandwidth) of the highest dimension elements, which share their nodes with all others:
+    Integer dimension = 3;
+    while (dimension > 1 && GetNumElements(dimension) == 0) {
+        --dimension;
+    }
+    const auto bandwidth = GetBandwidth(dimension);
+
+    ThreadPool pool(_numThreads);
+    const auto node_order = ordering == NodeOrdering::ReverseCuthillMcKee ? ReverseCuthillMcKee(GetNodeNodes(dimension))
+                                                                          : HilbertOrder(_nodes, pool);
+    const auto new_node = Inverse(node_order);
+
+    _nodes = Permute(_nodes, node_order);
+    _originalNodes = OriginalIndices(_originalNodes, node_order);
+
+    for (auto &[name, values] : _scalarFields) {
+        values = Permute(values, node_order);
+    }
+    for (auto &[name, values] : _vectorFields) {
+        values = Permute(values, node_order);
+    }
+    for (auto &[name, values] : _tensorFields) {
+        values = Permute(values, node_order);
+    }
+
+    // Renumber the nodes of the elements and sort the elements of every block by their lowest node, so assembly walks
+    // through the nodes (and matrix rows) in about the same order as the solver:
+    for (size_t element_dimension = 0; element_dimension < _elementBlocks.size(); ++element_dimension) {
+        const auto num_elements = GetNumElements(static_cast<Integer>(element_dimension));
+        std::vector<Integer> element_order(static_cast<size_t>(num_elements));
+        for (auto &block : _elementBlocks[element_dimension]) {
+            Renumber(block.node_indices, new_node);
+
+            std::vector<Integer> lowest_node(static_cast<size_t>(block.NumElements()));
+            for (Integer ii = 0; ii < block.NumElements(); ++ii) {
+                const auto element_nodes = block.ElementNodes(ii);
+                lowest_node[static_cast<size_t>(ii)] = *std::min_element(element_nodes.begin(), element_nodes.end());
+            }
+
+            const auto block_order = std::span<Integer>(element_order)
+                                         .subspan(static_cast<size_t>(block.first_element), lowest_node.size());
+            std::iota(block_order.begin(), block_order.end(), 0);
+            std::stable_sort(block_order.begin(), block_order.end(), [&](Integer lhs, Integer rhs) {
+                return lowest_node[static_cast<size_t>(lhs)] < lowest_node[static_cast<size_t>(rhs)];
+            });
+
+            std::vector<Integer> node_indices;
+            node_indices.reserve(block.node_indices.size());
+            for (auto &index : block_order) {
+                const auto element_nodes = block.ElementNodes(index);
+                node_indices.insert(node_indices.end(), element_nodes.begin(), element_nodes.end());
+                index += block.first_element;
+            }
+            block.node_indices = std::move(node_indices);
+        }
+
+        auto &original_elements = _originalElements[element_dimension];
+        original_elements = OriginalIndices(original_elements, element_order);
+
+        const auto new_element = Inverse(element_order);
+        for (auto &[tag, entity] : _entities) {
+            auto &items = entity[element_dimension];
+            Renumber(items, element_dimension == 0 ? std::span<const Integer>(new_node)
+                                                   : std::span<const Integer>(new_element));
+            std::sort(items.begin(), items.end());
+        }
+    }
+
+    // The adjacencies of the old numbering:
+    for (auto *adjacency : {&_nodeElements, &_nodeNodes, &_elementNeighbors}) {
+        for (auto &item : *adjacency) {
+            item.reset();
+        }
+    }
+
+    const std::chrono::duration<Float> elapsed = std::chrono::steady_clock::now() - start;
+    Log::Info("Reordered the mesh nodes in {:.3f} s, bandwidth {} -> {}", elapsed.count(), bandwidth,
+              GetBandwidth(dimension));
+}
+
+} // namespace plasmatic
@@ -0,0 +1,218 @@
+#include "interface/Mesh/Partition.h"
+
+#ifdef PLASMATIC_HAS_PARMETIS
+#include <mpi.h>
+#include <parmetis.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+
+namespace plasmatic {
+
+namespace {
+
+Float Component(const Coord &coord, size_t axis) {
+    const std::array<Float, 3> components = {coord.x, coord.y, coord.z};
+    return components[axis];
+}
+
+// Assigns parts [first_part, first_part + num_parts) to the elements by splitting them at the (part weighted) median
+// centroid along the longest axis of their bounding box and recursing into both halves:
+void Bisect(std::span<Integer> elements, const std::vector<Coord> &centroids, Integer first_part, Integer num_parts,
+            std::vector<Integer> &element_parts) {
+    if (num_parts == 1 || elements.size() <= 1) {
+        for (const auto &element_id : elements) {
+            element_parts[static_cast<size_t>(element_id)] = first_part;
+        }
+        return;
+    }
+
+    std::array<Float, 3> lower = {};
+    std::array<Float, 3> upper = {};
+    for (size_t axis = 0; axis < 3; ++axis) {
+        lower[axis] = std::numeric_limits<Float>::max();
+        upper[axis] = std::numeric_limits<Float>::lowest();
+        for (const auto &element_id : elements) {
+            const auto value = Component(centroids[static_cast<size_t>(element_id)], axis);
+            lower[axis] = std::min(lower[axis], value);
+            upper[axis] = std::max(upper[axis], value);
+        }
+    }
+
+    size_t axis = 0;
+    for (size_t ii = 1; ii < 3; ++ii) {
+        if (upper[ii] - lower[ii] > upper[axis] - lower[axis]) {
+            axis = ii;
+        }
+    }
+
+    const auto left_parts = num_parts / 2;
+    const auto split = elements.size() * static_cast<size_t>(left_parts) / static_cast<size_t>(num_parts);
+    std::nth_element(elements.begin(), elements.begin() + static_cast<std::ptrdiff_t>(split), elements.end(),
+                     [&centroids, axis](Integer lhs, Integer rhs) {
+                         return Component(centroids[static_cast<size_t>(lhs)], axis) <
+                                Component(centroids[static_cast<size_t>(rhs)], axis);
+                     });
+
+    Bisect(elements.first(split), centroids, first_part, left_parts, element_parts);
+    Bisect(elements.subspan(split), centroids, first_part + left_parts, num_parts - left_parts, element_parts);
+}
+
+std::vector<Integer> PartitionRecursiveBisection(const Mesh &mesh, Integer dimension, Integer num_parts) {
+    const auto num_elements = static_cast<size_t>(mesh.GetNumElements(dimension));
+
+    std::vector<Coord> centroids(num_elements, {.x = 0.0, .y = 0.0, .z = 0.0});
+    for (size_t ii = 0; ii < num_elements; ++ii) {
+        const auto element_nodes = mesh.GetElementNodes(dimension, static_cast<Integer>(ii));
+        for (const auto &node : element_nodes) {
+            const auto position = mesh.GetNodePosition(node);
+            centroids[ii].x += position.x / static_cast<Float>(element_nodes.size());
+            centroids[ii].y += position.y / static_cast<Float>(element_nodes.size());
+            centroids[ii].z += position.z / static_cast<Float>(element_nodes.size());
+        }
+    }
+
+    std::vector<Integer> elements(num_elements);
+    for (size_t ii = 0; ii < num_elements; ++ii) {
+        elements[ii] = static_cast<Integer>(ii);
+    }
+
+    std::vector<Integer> element_parts(num_elements, 0);
+    Bisect(elements, centroids, 0, num_parts, element_parts);
+
+    return element_parts;
+}
+
+#ifdef PLASMATIC_HAS_PARMETIS
+std::vector<Integer> PartitionParMETIS(const Mesh &mesh, Integer dimension, Integer num_parts) {
+    const auto num_elements = mesh.GetNumElements(dimension);
+
+    // The whole mesh lives on this rank, so it is handed to ParMETIS on a communicator of its own:
+    std::vector<idx_t> element_distribution = {0, num_elements};
+    std::vector<idx_t> element_offsets = {0};
+    std::vector<idx_t> element_nodes;
+    for (Integer ii = 0; ii < num_elements; ++ii) {
+        for (const auto &node : mesh.GetElementNodes(dimension, ii)) {
+            element_nodes.push_back(node);
+        }
+        element_offsets.push_back(static_cast<idx_t>(element_nodes.size()));
+    }
+
+    idx_t weight_flag = 0;
+    idx_t num_flag = 0;
+    idx_t num_constraints = 1;
+    idx_t num_common_nodes = dimension;
+    idx_t parts = num_parts;
+    std::vector<real_t> target_weights(static_cast<size_t>(num_parts), 1.0F / static_cast<real_t>(num_parts));
+    real_t imbalance_tolerance = 1.05F; // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    std::array<idx_t, 3> options = {0, 0, 0};
+    idx_t edge_cut = 0;
+    std::vector<idx_t> element_parts(static_cast<size_t>(num_elements), 0);
+    MPI_Comm comm = MPI_COMM_SELF;
+
+    const auto status = ParMETIS_V3_PartMeshKway(
+        element_distribution.data(), element_offsets.data(), element_nodes.data(), nullptr, &weight_flag, &num_flag,
+        &num_constraints, &num_common_nodes, &parts, target_weights.data(), &imbalance_tolerance, options.data(),
+        &edge_cut, element_parts.data(), &comm);
+    Check(status == METIS_OK, "ParMETIS returned a non-zero error code: {}", status);
+
+    return {element_parts.begin(), element_parts.end()};
+}
+#else
+std::vector<Integer> PartitionParMETIS(const Mesh & /*mesh*/, Integer /*dimension*/, Integer /*num_parts*/) {
+    Abort("Plasmatic was built without ParMETIS");
+}
+#endif
+
+} // namespace
+
+bool HasParMETIS() {
+#ifdef PLASMATIC_HAS_PARMETIS
+    return true;
+#else
+    return false;
+#endif
+}
+
+MeshPartition PartitionMesh(const Mesh &mesh, Integer dimension, Integer num_parts, PartitionMethod method) {
+    Check(num_parts >= 1, "Cannot split a mesh into {} parts", num_parts);
+
+    MeshPartition partition = {.dimension = dimension, .num_parts = num_parts, .element_parts = {}};
+
+    if (num_parts == 1) {
+        partition.element_parts.assign(static_cast<size_t>(mesh.GetNumElements(dimension)), 0);
+        return partition;
+    }
+
+    switch (method) {
+    case PartitionMethod::RecursiveBisection:
+        partition.element_parts = PartitionRecursiveBisection(mesh, dimension, num_parts);
+        break;
+    case PartitionMethod::ParMETIS:
+        partition.element_parts = PartitionParMETIS(mesh, dimension, num_parts);
+        break;
+    }
+
+    return partition;
+}
+
+PartitionStats ComputePartitionStats(const Mesh &mesh, const MeshPartition &partition) {
+    const auto dimension = partition.dimension;
+    const auto num_elements = static_cast<size_t>(mesh.GetNumElements(dimension));
+
+    PartitionStats stats = {
+        .part_sizes = std::vector<Integer>(static_cast<size_t>(partition.num_parts), 0),
+        .imbalance = 0.0,
+        .edge_cut = 0,
+        .interface_nodes = 0};
+
+    for (const auto &part : partition.element_parts) {
+        stats.part_sizes[static_cast<size_t>(part)]++;
+    }
+
+    const auto average_size = static_cast<Float>(num_elements) / static_cast<Float>(partition.num_parts);
+    stats.imbalance = static_cast<Float>(*std::max_element(stats.part_sizes.begin(), stats.part_sizes.end())) /
+                      std::max(average_size, 1.0);
+
+    const auto &node_elements = mesh.GetNodeElements(dimension);
+    for (Integer node = 0; node < mesh.GetNumNodes(); ++node) {
+        const auto elements = node_elements.Neighbors(node);
+        for (const auto &element_id : elements) {
+            if (partition.element_parts[static_cast<size_t>(element_id)] !=
+                partition.element_parts[static_cast<size_t>(elements.front())]) {
+                stats.interface_nodes++;
+                break;
+            }
+        }
+    }
+
+    // Every pair of face neighbors is seen from both sides, so only the side with the smaller id counts it:
+    const auto &element_neighbors = mesh.GetElementNeighbors(dimension);
+    for (Integer element_id = 0; element_id < element_neighbors.NumItems(); ++element_id) {
+        for (const auto &neighbor : element_neighbors.Neighbors(element_id)) {
+            if (neighbor > element_id && partition.element_parts[static_cast<size_t>(neighbor)] !=
+                                             partition.element_parts[static_cast<size_t>(element_id)]) {
+                stats.edge_cut++;
+            }
+        }
+    }
+
+    return stats;
+}
+
+void WritePartitionVTK(const Mesh &mesh, const MeshPartition &partition, const std::filesystem::path &base_filename) {
+    std::vector<std::vector<Integer>> part_elements(static_cast<size_t>(partition.num_parts));
+    for (size_t ii = 0; ii < partition.element_parts.size(); ++ii) {
+        part_elements[static_cast<size_t>(partition.element_parts[ii])].push_back(static_cast<Integer>(ii));
+    }
+
+    for (size_t part = 0; part < part_elements.size(); ++part) {
+        mesh.WriteVTK(base_filename.string() + "_" + std::to_string(part) + ".vtk", partition.dimension,
+                      part_elements[part]);
+    }
+}
+
+} // namespace plasmatic
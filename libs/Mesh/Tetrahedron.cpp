@@ -4,8 +4,80 @@
 
 namespace plasmatic {
 
-Tetrahedron::Tetrahedron(const std::array<Integer, 4> &node_indices, std::shared_ptr<std::vector<Coord>> nodes)
-    : _nodeIndices(node_indices), _nodes(std::move(nodes)) {}
+namespace {
+// lambda_i are the shape functions, xi, eta, and zeta are the parent coordinates
+// lambda_1 = 1 - xi - eta - zeta
+// lambda_2 = xi
+// lambda_3 = eta
+// lambda_4 = zeta
+constexpr Float ReferenceShapeFn(Integer index, const std::array<Float, 3> &parent_coords) {
+    const auto &xi = parent_coords[0];
+    const auto &eta = parent_coords[1];
+    const auto &zeta = parent_coords[2];
+
+    if (index == 0) {
+        return 1.0 - xi - eta - zeta;
+    }
+
+    if (index == 1) {
+        return xi;
+    }
+
+    if (index == 2) {
+        return eta;
+    }
+
+    if (index == 3) {
+        return zeta;
+    }
+
+    Abort("Invalid shape function index: {}", index);
+}
+
+constexpr Float ReferenceShapeFnDerivative(Integer index, Integer dimension,
+                                           [[maybe_unused]] const std::array<Float, 3> &parent_coords) {
+    if (index == 0) {
+        return -1.0;
+    }
+
+    if (index == 1) {
+        if (dimension == 0) {
+            return 1.0;
+        }
+
+        return 0.0;
+    }
+
+    if (index == 2) {
+        if (dimension == 1) {
+            return 1.0;
+        }
+
+        return 0.0;
+    }
+
+    if (index == 3) {
+        if (dimension == 2) {
+            return 1.0;
+        }
+
+        return 0.0;
+    }
+
+    Abort("Invalid index in ShapeFnDerivative");
+}
+
+constexpr auto alpha = 0.5854102;
+constexpr auto beta = 0.1381966;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+constexpr auto reference_table = MakeReferenceTable<4, 3, 4>(
+    {{{beta, beta, beta}, {alpha, beta, beta}, {beta, alpha, beta}, {beta, beta, alpha}}},
+    {0.25 / 6.0, 0.25 / 6.0, 0.25 / 6.0, 0.25 / 6.0}, ReferenceShapeFn, ReferenceShapeFnDerivative);
+} // namespace
+
+Tetrahedron::Tetrahedron(const std::array<Integer, 4> &node_indices, std::span<const Coord> nodes)
+    : _nodeIndices(node_indices), _nodes(nodes) {}
 
 Float Tetrahedron::ComputeVolume(const Coord &p0, const Coord &p1, const Coord &p2, const Coord &p3) {
     auto volume_6x =
@@ -19,22 +91,22 @@ Float Tetrahedron::ComputeVolume(const Coord &p0, const Coord &p1, const Coord &
 
 std::array<Float, 3> Tetrahedron::PhysicalToParentCoords(const Coord &coord) const {
     auto volume = Tetrahedron::ComputeVolume(
-        (*_nodes)[static_cast<size_t>(_nodeIndices[0])], (*_nodes)[static_cast<size_t>(_nodeIndices[1])],
-        (*_nodes)[static_cast<size_t>(_nodeIndices[2])], (*_nodes)[static_cast<size_t>(_nodeIndices[3])]);
+        _nodes[static_cast<size_t>(_nodeIndices[0])], _nodes[static_cast<size_t>(_nodeIndices[1])],
+        _nodes[static_cast<size_t>(_nodeIndices[2])], _nodes[static_cast<size_t>(_nodeIndices[3])]);
 
-    auto lambda2 = Tetrahedron::ComputeVolume((*_nodes)[static_cast<size_t>(_nodeIndices[3])],
-                                              (*_nodes)[static_cast<size_t>(_nodeIndices[0])],
-                                              (*_nodes)[static_cast<size_t>(_nodeIndices[2])], coord) /
+    auto lambda2 = Tetrahedron::ComputeVolume(_nodes[static_cast<size_t>(_nodeIndices[3])],
+                                              _nodes[static_cast<size_t>(_nodeIndices[0])],
+                                              _nodes[static_cast<size_t>(_nodeIndices[2])], coord) /
                    volume;
 
-    auto lambda3 = Tetrahedron::ComputeVolume((*_nodes)[static_cast<size_t>(_nodeIndices[3])],
-                                              (*_nodes)[static_cast<size_t>(_nodeIndices[1])],
-                                              (*_nodes)[static_cast<size_t>(_nodeIndices[0])], coord) /
+    auto lambda3 = Tetrahedron::ComputeVolume(_nodes[static_cast<size_t>(_nodeIndices[3])],
+                                              _nodes[static_cast<size_t>(_nodeIndices[1])],
+                                              _nodes[static_cast<size_t>(_nodeIndices[0])], coord) /
                    volume;
 
-    auto lambda4 = Tetrahedron::ComputeVolume((*_nodes)[static_cast<size_t>(_nodeIndices[0])],
-                                              (*_nodes)[static_cast<size_t>(_nodeIndices[1])],
-                                              (*_nodes)[static_cast<size_t>(_nodeIndices[2])], coord) /
+    auto lambda4 = Tetrahedron::ComputeVolume(_nodes[static_cast<size_t>(_nodeIndices[0])],
+                                              _nodes[static_cast<size_t>(_nodeIndices[1])],
+                                              _nodes[static_cast<size_t>(_nodeIndices[2])], coord) /
                    volume;
 
     const auto xi = lambda2;
@@ -59,183 +131,89 @@ Coord Tetrahedron::ParentToPhysicalCoords(const std::array<Float, 3> &parent_coo
     // NOLINTNEXTLINE(clang-diagnostic-pre-c++20-compat-pedantic)
     Coord point = {.x = 0.0, .y = 0.0, .z = 0.0};
     for (size_t ii = 0; ii < static_cast<size_t>(this->NumNodes()); ++ii) {
-        point.x += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].x * lambda[ii];
-        point.y += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].y * lambda[ii];
-        point.z += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].z * lambda[ii];
+        point.x += _nodes[static_cast<size_t>(_nodeIndices[ii])].x * lambda[ii];
+        point.y += _nodes[static_cast<size_t>(_nodeIndices[ii])].y * lambda[ii];
+        point.z += _nodes[static_cast<size_t>(_nodeIndices[ii])].z * lambda[ii];
     }
 
     return point;
 }
 
-Float Tetrahedron::ShapeFn(Integer index, [[maybe_unused]] const Coord &coord) const {
-    auto parent_coords = PhysicalToParentCoords(coord);
-
-    const auto &xi = parent_coords[0];
-    const auto &eta = parent_coords[1];
-    const auto &zeta = parent_coords[2];
+const Tetrahedron::Table &Tetrahedron::GetReferenceTable() { return reference_table; }
 
-    if (index == 0) {
-        return 1.0 - xi - eta - zeta;
+Tetrahedron::Quadrature Tetrahedron::EvaluateQuadrature() const {
+    Eigen::Matrix<Float, 4, 3> node_coords;
+    for (Integer ii = 0; ii < 4; ++ii) {
+        const auto &node = _nodes[static_cast<size_t>(_nodeIndices[static_cast<size_t>(ii)])];
+        node_coords(ii, 0) = node.x;
+        node_coords(ii, 1) = node.y;
+        node_coords(ii, 2) = node.z;
     }
 
-    if (index == 1) {
-        return xi;
-    }
+    Quadrature quadrature;
+    EvaluateReferenceTable(reference_table, node_coords, quadrature);
 
-    if (index == 2) {
-        return eta;
+    for (size_t ii = 0; ii < quadrature.points.size(); ++ii) {
+        quadrature.points[ii] = ParentToPhysicalCoords(reference_table.points[ii]);
     }
 
-    if (index == 3) {
-        return zeta;
-    }
+    return quadrature;
+}
 
-    Abort("Invalid shape function index: {}", index);
+Float Tetrahedron::ShapeFn(Integer index, const Coord &coord) const {
+    return ReferenceShapeFn(index, PhysicalToParentCoords(coord));
 }
 
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-Float Tetrahedron::ShapeFnDerivative(Integer index, Integer dimension, [[maybe_unused]] Float xi,
-                                     [[maybe_unused]] Float eta, [[maybe_unused]] Float zeta) const {
-    Check(dimension >= 0 && dimension <= 3, "Invalid dimension in ShapeFnDerivative");
-
-    // lambda_i are the shape functions, xi, eta, and zeta are the parent coordinates
-    // lambda_1 = 1 - xi - eta - zeta
-    // lambda_2 = xi
-    // lambda_3 = eta
-    // lambda_4 = zeta
-
-    if (index == 0) {
-        return -1.0;
-    }
-
-    if (index == 1) {
-        if (dimension == 0) {
-            return 1.0;
-        }
-
-        return 0.0;
-    }
-
-    if (index == 2) {
-        if (dimension == 1) {
-            return 1.0;
-        }
-
-        return 0.0;
-    }
+Float Tetrahedron::ShapeFnDerivative(Integer index, Integer dimension, Float xi, Float eta, Float zeta) const {
+    Check(dimension >= 0 && dimension < 3, "Invalid dimension in ShapeFnDerivative");
 
-    if (index == 3) {
-        if (dimension == 2) {
-            return 1.0;
-        }
-
-        return 0.0;
-    }
-
-    Abort("Invalid index in ShapeFnDerivative");
+    return ReferenceShapeFnDerivative(index, dimension, {xi, eta, zeta});
 }
 
-Float Tetrahedron::ShapeFnDerivative(Integer index, Integer dimension, [[maybe_unused]] const Coord &coord) const {
-    Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(3, 3);
+Float Tetrahedron::ShapeFnDerivative(Integer index, Integer dimension, const Coord &coord) const {
+    Check(index >= 0 && index < 4, "Invalid index in ShapeFnDerivative");
+    Check(dimension >= 0 && dimension < 3, "Invalid shape function derivative dimension: {}", dimension);
 
-    auto parent_coords = PhysicalToParentCoords(coord);
+    const auto parent_coords = PhysicalToParentCoords(coord);
+
+    Eigen::Matrix<Float, 3, 4> parent_derivatives;
+    Eigen::Matrix<Float, 4, 3> node_coords;
+    for (Integer ii = 0; ii < 4; ++ii) {
+        const auto &node = _nodes[static_cast<size_t>(_nodeIndices[static_cast<size_t>(ii)])];
+        node_coords(ii, 0) = node.x;
+        node_coords(ii, 1) = node.y;
+        node_coords(ii, 2) = node.z;
 
-    for (size_t ii = 0; ii < 4; ++ii) {
         for (Integer jj = 0; jj < 3; ++jj) {
-            jacobian(jj, 0) +=
-                (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].x *
-                ShapeFnDerivative(static_cast<Integer>(ii), jj, parent_coords[0], parent_coords[1], parent_coords[2]);
-            jacobian(jj, 1) +=
-                (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].y *
-                ShapeFnDerivative(static_cast<Integer>(ii), jj, parent_coords[0], parent_coords[1], parent_coords[2]);
-            jacobian(jj, 2) +=
-                (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].z *
-                ShapeFnDerivative(static_cast<Integer>(ii), jj, parent_coords[0], parent_coords[1], parent_coords[2]);
+            parent_derivatives(jj, ii) = ReferenceShapeFnDerivative(ii, jj, parent_coords);
         }
     }
 
-    Eigen::VectorXd shape_fn_derivs = Eigen::VectorXd::Zero(3);
-
-    for (Integer jj = 0; jj < 3; ++jj) {
-        shape_fn_derivs(jj) = ShapeFnDerivative(index, jj, parent_coords[0], parent_coords[1], parent_coords[2]);
-    }
-
-    Eigen::VectorXd global_derivs = jacobian.colPivHouseholderQr().solve(shape_fn_derivs);
+    const Eigen::Matrix<Float, 3, 3> jacobian = parent_derivatives * node_coords;
+    const Eigen::Vector3d global_derivs = jacobian.partialPivLu().solve(parent_derivatives.col(index));
 
-    Check(dimension >= 0 && dimension <= 3, "Invalid shape function derivative dimension: {}", dimension);
     return global_derivs(dimension);
 }
 
-Float Tetrahedron::Integrate([[maybe_unused]] const std::function<Float(const Coord &)> integrand) const {
-    constexpr auto alpha = 0.5854102;
-    constexpr auto beta = 0.1381966;
-
-    std::vector<std::array<Float, 3>> gauss_coords = {
-        {beta, beta, beta}, {alpha, beta, beta}, {beta, alpha, beta}, {beta, beta, alpha}};
-
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
-    std::vector<Float> weights = {0.25, 0.25, 0.25, 0.25};
+Float Tetrahedron::Integrate(const std::function<Float(const Coord &)> integrand) const {
+    const auto quadrature = EvaluateQuadrature();
 
     Float result = 0.0;
-
-    for (size_t ii = 0; ii < gauss_coords.size(); ++ii) {
-        auto gauss_point = ParentToPhysicalCoords(gauss_coords[ii]);
-
-        Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(3, 3);
-
-        for (size_t kk = 0; kk < static_cast<size_t>(this->NumNodes()); ++kk) {
-            for (Integer jj = 0; jj < 3; ++jj) {
-                jacobian(jj, 0) += (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].x *
-                                   ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0],
-                                                     gauss_coords[ii][1], gauss_coords[ii][2]);
-                jacobian(jj, 1) += (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].y *
-                                   ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0],
-                                                     gauss_coords[ii][1], gauss_coords[ii][2]);
-                jacobian(jj, 2) += (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].z *
-                                   ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0],
-                                                     gauss_coords[ii][1], gauss_coords[ii][2]);
-            }
-        }
-
-        result += weights[ii] * integrand(gauss_point) * jacobian.determinant() / 6.0;
+    for (size_t ii = 0; ii < quadrature.points.size(); ++ii) {
+        result += quadrature.weights[ii] * integrand(quadrature.points[ii]);
     }
 
     return result;
 }
 
-Eigen::MatrixXd Tetrahedron::Integrate([[maybe_unused]] const std::function<Eigen::MatrixXd(const Coord &)> integrand,
-                                       Integer rows, Integer cols) const {
-    constexpr auto alpha = 0.5854102;
-    constexpr auto beta = 0.1381966;
-
-    std::vector<std::array<Float, 3>> gauss_coords = {
-        {beta, beta, beta}, {alpha, beta, beta}, {beta, alpha, beta}, {beta, beta, alpha}};
-
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
-    std::vector<Float> weights = {0.25, 0.25, 0.25, 0.25};
+Eigen::MatrixXd Tetrahedron::Integrate(const std::function<Eigen::MatrixXd(const Coord &)> integrand, Integer rows,
+                                       Integer cols) const {
+    const auto quadrature = EvaluateQuadrature();
 
     Eigen::MatrixXd result = Eigen::MatrixXd::Zero(rows, cols);
-
-    for (size_t ii = 0; ii < gauss_coords.size(); ++ii) {
-        auto gauss_point = ParentToPhysicalCoords(gauss_coords[ii]);
-
-        Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(3, 3);
-
-        for (size_t kk = 0; kk < static_cast<size_t>(this->NumNodes()); ++kk) {
-            for (Integer jj = 0; jj < 3; ++jj) {
-                jacobian(jj, 0) += (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].x *
-                                   ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0],
-                                                     gauss_coords[ii][1], gauss_coords[ii][2]);
-                jacobian(jj, 1) += (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].y *
-                                   ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0],
-                                                     gauss_coords[ii][1], gauss_coords[ii][2]);
-                jacobian(jj, 2) += (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].z *
-                                   ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0],
-                                                     gauss_coords[ii][1], gauss_coords[ii][2]);
-            }
-        }
-
-        result += weights[ii] * integrand(gauss_point) * jacobian.determinant() / 6.0;
+    for (size_t ii = 0; ii < quadrature.points.size(); ++ii) {
+        result += quadrature.weights[ii] * integrand(quadrature.points[ii]);
     }
 
     return result;
@@ -4,8 +4,61 @@
 
 namespace plasmatic {
 
-Triangle::Triangle(const std::array<Integer, 3> &node_indices, std::shared_ptr<std::vector<Coord>> nodes)
-    : _nodeIndices(node_indices), _nodes(std::move(nodes)) {}
+namespace {
+// lambda_i are the shape functions, xi and eta are the parent coordinates
+// lambda_1 = 1 - xi - eta
+// lambda_2 = xi
+// lambda_3 = eta
+constexpr Float ReferenceShapeFn(Integer index, const std::array<Float, 2> &parent_coords) {
+    const auto &xi = parent_coords[0];
+    const auto &eta = parent_coords[1];
+
+    if (index == 0) {
+        return 1.0 - xi - eta;
+    }
+
+    if (index == 1) {
+        return xi;
+    }
+
+    if (index == 2) {
+        return eta;
+    }
+
+    Abort("Invalid shape function index: {}", index);
+}
+
+constexpr Float ReferenceShapeFnDerivative(Integer index, Integer dimension,
+                                           [[maybe_unused]] const std::array<Float, 2> &parent_coords) {
+    if (index == 0) {
+        return -1.0;
+    }
+
+    if (index == 1) {
+        if (dimension == 0) {
+            return 1.0;
+        }
+
+        return 0.0;
+    }
+
+    if (index == 2) {
+        if (dimension == 1) {
+            return 1.0;
+        }
+
+        return 0.0;
+    }
+
+    Abort("Invalid index in ShapeFnDerivative");
+}
+
+constexpr auto reference_table =
+    MakeReferenceTable<3, 2, 1>({{{1.0 / 3.0, 1.0 / 3.0}}}, {0.5}, ReferenceShapeFn, ReferenceShapeFnDerivative);
+} // namespace
+
+Triangle::Triangle(const std::array<Integer, 3> &node_indices, std::span<const Coord> nodes)
+    : _nodeIndices(node_indices), _nodes(nodes) {}
 
 Float Triangle::ComputeArea(const Coord &p1, const Coord &p2, const Coord &p3) {
     auto x12 = p2.x - p1.x;
@@ -21,15 +74,15 @@ Float Triangle::ComputeArea(const Coord &p1, const Coord &p2, const Coord &p3) {
 }
 
 std::array<Float, 2> Triangle::PhysicalToParentCoords(const Coord &coord) const {
-    auto area = Triangle::ComputeArea((*_nodes)[static_cast<size_t>(_nodeIndices[0])],
-                                      (*_nodes)[static_cast<size_t>(_nodeIndices[1])],
-                                      (*_nodes)[static_cast<size_t>(_nodeIndices[2])]);
+    auto area = Triangle::ComputeArea(_nodes[static_cast<size_t>(_nodeIndices[0])],
+                                      _nodes[static_cast<size_t>(_nodeIndices[1])],
+                                      _nodes[static_cast<size_t>(_nodeIndices[2])]);
 
-    auto lambda2 = Triangle::ComputeArea(coord, (*_nodes)[static_cast<size_t>(_nodeIndices[0])],
-                                         (*_nodes)[static_cast<size_t>(_nodeIndices[2])]) /
+    auto lambda2 = Triangle::ComputeArea(coord, _nodes[static_cast<size_t>(_nodeIndices[0])],
+                                         _nodes[static_cast<size_t>(_nodeIndices[2])]) /
                    area;
-    auto lambda3 = Triangle::ComputeArea(coord, (*_nodes)[static_cast<size_t>(_nodeIndices[0])],
-                                         (*_nodes)[static_cast<size_t>(_nodeIndices[1])]) /
+    auto lambda3 = Triangle::ComputeArea(coord, _nodes[static_cast<size_t>(_nodeIndices[0])],
+                                         _nodes[static_cast<size_t>(_nodeIndices[1])]) /
                    area;
 
     const auto xi = lambda2;
@@ -51,117 +104,75 @@ Coord Triangle::ParentToPhysicalCoords(const std::array<Float, 2> &parent_coords
     // NOLINTNEXTLINE(clang-diagnostic-pre-c++20-compat-pedantic)
     Coord point = {.x = 0.0, .y = 0.0, .z = 0.0};
     for (size_t ii = 0; ii < static_cast<size_t>(this->NumNodes()); ++ii) {
-        point.x += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].x * lambda[ii];
-        point.y += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].y * lambda[ii];
-        point.z += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].z * lambda[ii];
+        point.x += _nodes[static_cast<size_t>(_nodeIndices[ii])].x * lambda[ii];
+        point.y += _nodes[static_cast<size_t>(_nodeIndices[ii])].y * lambda[ii];
+        point.z += _nodes[static_cast<size_t>(_nodeIndices[ii])].z * lambda[ii];
     }
 
     return point;
 }
 
-Float Triangle::ShapeFn([[maybe_unused]] Integer index, [[maybe_unused]] const Coord &coord) const {
-    auto parent_coords = PhysicalToParentCoords(coord);
-
-    const auto &xi = parent_coords[0];
-    const auto &eta = parent_coords[1];
+const Triangle::Table &Triangle::GetReferenceTable() { return reference_table; }
 
-    if (index == 0) {
-        return 1.0 - xi - eta;
+Triangle::Quadrature Triangle::EvaluateQuadrature() const {
+    Eigen::Matrix<Float, 3, 2> node_coords;
+    for (Integer ii = 0; ii < 3; ++ii) {
+        const auto &node = _nodes[static_cast<size_t>(_nodeIndices[static_cast<size_t>(ii)])];
+        node_coords(ii, 0) = node.x;
+        node_coords(ii, 1) = node.y;
     }
 
-    if (index == 1) {
-        return xi;
-    }
+    Quadrature quadrature;
+    EvaluateReferenceTable(reference_table, node_coords, quadrature);
 
-    if (index == 2) {
-        return eta;
+    for (size_t ii = 0; ii < quadrature.points.size(); ++ii) {
+        quadrature.points[ii] = ParentToPhysicalCoords(reference_table.points[ii]);
     }
 
-    Abort("Invalid shape function index: {}", index);
+    return quadrature;
 }
 
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-Float Triangle::ShapeFnDerivative(Integer index, Integer dimension, [[maybe_unused]] Float xi,
-                                  [[maybe_unused]] Float eta) const {
-    Check(dimension >= 0 && dimension <= 2, "Invalid dimension in ShapeFnDerivative");
-
-    // lambda_i are the shape functions, xi and eta are the parent coordinates
-    // lambda_1 = 1 - xi - eta
-    // lambda_2 = xi
-    // lambda_3 = eta
-
-    if (index == 0) {
-        return -1.0;
-    }
-
-    if (index == 1) {
-        if (dimension == 0) {
-            return 1.0;
-        }
-
-        return 0.0;
-    }
-
-    if (index == 2) {
-        if (dimension == 1) {
-            return 1.0;
-        }
+Float Triangle::ShapeFn(Integer index, const Coord &coord) const {
+    return ReferenceShapeFn(index, PhysicalToParentCoords(coord));
+}
 
-        return 0.0;
-    }
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+Float Triangle::ShapeFnDerivative(Integer index, Integer dimension, Float xi, Float eta) const {
+    Check(dimension >= 0 && dimension < 2, "Invalid dimension in ShapeFnDerivative");
 
-    Abort("Invalid index in ShapeFnDerivative");
+    return ReferenceShapeFnDerivative(index, dimension, {xi, eta});
 }
 
 Float Triangle::ShapeFnDerivative(Integer index, Integer dimension, const Coord &coord) const {
-    Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(2, 2);
+    Check(index >= 0 && index < 3, "Invalid index in ShapeFnDerivative");
+    Check(dimension >= 0 && dimension < 2, "Invalid shape function derivative dimension: {}", dimension);
+
+    const auto parent_coords = PhysicalToParentCoords(coord);
 
-    auto parent_coords = PhysicalToParentCoords(coord);
+    Eigen::Matrix<Float, 2, 3> parent_derivatives;
+    Eigen::Matrix<Float, 3, 2> node_coords;
+    for (Integer ii = 0; ii < 3; ++ii) {
+        const auto &node = _nodes[static_cast<size_t>(_nodeIndices[static_cast<size_t>(ii)])];
+        node_coords(ii, 0) = node.x;
+        node_coords(ii, 1) = node.y;
 
-    for (size_t ii = 0; ii < 3; ++ii) {
         for (Integer jj = 0; jj < 2; ++jj) {
-            jacobian(jj, 0) += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].x *
-                               ShapeFnDerivative(static_cast<Integer>(ii), jj, parent_coords[0], parent_coords[1]);
-            jacobian(jj, 1) += (*_nodes)[static_cast<size_t>(_nodeIndices[ii])].y *
-                               ShapeFnDerivative(static_cast<Integer>(ii), jj, parent_coords[0], parent_coords[1]);
+            parent_derivatives(jj, ii) = ReferenceShapeFnDerivative(ii, jj, parent_coords);
         }
     }
 
-    Eigen::VectorXd shape_fn_derivs = Eigen::VectorXd::Zero(2);
+    const Eigen::Matrix<Float, 2, 2> jacobian = parent_derivatives * node_coords;
+    const Eigen::Vector2d global_derivs = jacobian.partialPivLu().solve(parent_derivatives.col(index));
 
-    for (Integer jj = 0; jj < 2; ++jj) {
-        shape_fn_derivs(jj) = ShapeFnDerivative(index, jj, parent_coords[0], parent_coords[1]);
-    }
-
-    Eigen::VectorXd global_derivs = jacobian.colPivHouseholderQr().solve(shape_fn_derivs);
-
-    Check(dimension >= 0 && dimension <= 2, "Invalid shape function derivative dimension: {}", dimension);
     return global_derivs(dimension);
 }
 
 Float Triangle::Integrate(const std::function<Float(const Coord &)> integrand) const {
-    std::vector<std::array<Float, 2>> gauss_coords = {{1.0 / 3.0, 1.0 / 3.0}};
-
-    std::vector<Float> weights = {1.0};
+    const auto quadrature = EvaluateQuadrature();
 
     Float result = 0.0;
-
-    for (size_t ii = 0; ii < gauss_coords.size(); ++ii) {
-        auto gauss_point = ParentToPhysicalCoords(gauss_coords[ii]);
-
-        Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(2, 2);
-        for (size_t kk = 0; kk < static_cast<size_t>(this->NumNodes()); ++kk) {
-            for (Integer jj = 0; jj < 2; ++jj) {
-                jacobian(jj, 0) +=
-                    (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].x *
-                    ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0], gauss_coords[ii][1]);
-                jacobian(jj, 1) +=
-                    (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].y *
-                    ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0], gauss_coords[ii][1]);
-            }
-        }
-
-        result += weights[ii] * integrand(gauss_point) * (0.5 * std::abs(jacobian.determinant()));
+    for (size_t ii = 0; ii < quadrature.points.size(); ++ii) {
+        result += quadrature.weights[ii] * integrand(quadrature.points[ii]);
     }
 
     return result;
@@ -169,28 +180,11 @@ Float Triangle::Integrate(const std::function<Float(const Coord &)> integrand) c
 
 Eigen::MatrixXd Triangle::Integrate(const std::function<Eigen::MatrixXd(const Coord &)> integrand, Integer rows,
                                     Integer cols) const {
-    std::vector<std::array<Float, 2>> gauss_coords = {{1.0 / 3.0, 1.0 / 3.0}};
-
-    std::vector<Float> weights = {1.0};
+    const auto quadrature = EvaluateQuadrature();
 
     Eigen::MatrixXd result = Eigen::MatrixXd::Zero(rows, cols);
-
-    for (size_t ii = 0; ii < gauss_coords.size(); ++ii) {
-        auto gauss_point = ParentToPhysicalCoords(gauss_coords[ii]);
-
-        Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(2, 2);
-        for (size_t kk = 0; kk < static_cast<size_t>(this->NumNodes()); ++kk) {
-            for (Integer jj = 0; jj < 2; ++jj) {
-                jacobian(jj, 0) +=
-                    (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].x *
-                    ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0], gauss_coords[ii][1]);
-                jacobian(jj, 1) +=
-                    (*_nodes)[static_cast<size_t>(_nodeIndices[kk])].y *
-                    ShapeFnDerivative(static_cast<Integer>(kk), jj, gauss_coords[ii][0], gauss_coords[ii][1]);
-            }
-        }
-
-        result += weights[ii] * integrand(gauss_point) * (0.5 * std::abs(jacobian.determinant()));
+    for (size_t ii = 0; ii < quadrature.points.size(); ++ii) {
+        result += quadrature.weights[ii] * integrand(quadrature.points[ii]);
     }
 
     return result;
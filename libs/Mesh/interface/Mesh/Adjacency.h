@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Utility/Utility.h"
+
+#include <span>
+#include <vector>
+
+namespace plasmatic {
+
+// Neighbors of a set of items in CSR form: the neighbors of item ii are neighbors[offsets[ii]] up to (but not
+// including) neighbors[offsets[ii + 1]].
+struct Adjacency {
+    std::vector<Integer> offsets;
+    std::vector<Integer> neighbors;
+
+    Integer NumItems() const { return static_cast<Integer>(offsets.size()) - 1; }
+
+    std::span<const Integer> Neighbors(Integer item) const {
+        const auto begin = static_cast<size_t>(offsets[static_cast<size_t>(item)]);
+        const auto end = static_cast<size_t>(offsets[static_cast<size_t>(item) + 1]);
+        return std::span<const Integer>(neighbors).subspan(begin, end - begin);
+    }
+
+    size_t MemoryBytes() const { return (offsets.size() + neighbors.size()) * sizeof(Integer); }
+};
+
+} // namespace plasmatic
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Coord.h"
+#include "Element.h"
+#include "Line.h"
+#include "LineOrder2.h"
+#include "Tetrahedron.h"
+#include "TetrahedronOrder2.h"
+#include "Triangle.h"
+#include "TriangleOrder2.h"
+
+#include "Utility/Utility.h"
+
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace plasmatic {
+
+// Number of nodes of the elements with the given VTK cell type, or -1 if the type isn't supported:
+Integer VTKCellTypeNumNodes(Integer vtk_cell_type);
+
+// Elements of one type with consecutive ids, starting at first_element. The node indices of all of them are stored one
+// element after the other, so loops over the connectivity need neither a virtual call nor an allocation per element.
+struct ElementBlock {
+    Integer vtk_cell_type;
+    Integer nodes_per_element;
+    Integer first_element;
+    std::vector<Integer> node_indices;
+
+    Integer NumElements() const { return static_cast<Integer>(node_indices.size()) / nodes_per_element; }
+
+    // Nodes of the element at the given position in the block (i.e. with id first_element + index):
+    std::span<const Integer> ElementNodes(Integer index) const {
+        return std::span<const Integer>(node_indices)
+            .subspan(static_cast<size_t>(index * nodes_per_element), static_cast<size_t>(nodes_per_element));
+    }
+};
+
+// An element made on the fly from its node indices in a block, for code that wants the Element interface (shape
+// functions, integration). It lives on the stack, copies the node indices and only refers to the node positions, so it
+// must not outlive the mesh.
+class ElementView {
+  public:
+    ElementView(Integer vtk_cell_type, std::span<const Integer> node_indices, std::span<const Coord> nodes);
+
+    const Element &operator*() const;
+
+    const Element *operator->() const { return &**this; }
+
+  private:
+    std::variant<Line, LineOrder2, Triangle, TriangleOrder2, Tetrahedron, TetrahedronOrder2> _element;
+};
+
+} // namespace plasmatic
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Element.h"
+#include "Tetrahedron.h"
+#include "TetrahedronOrder2.h"
+#include "Triangle.h"
+#include "TriangleOrder2.h"
+#include "Utility/Utility.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace plasmatic {
+
+// Calls visitor with the element downcast to its concrete type so that everything inside the visitor is resolved (and
+// inlined) at compile time. Only the area elements (Dim == 2) or volume elements (Dim == 3) are considered.
+template <Integer Dim, typename Visitor> decltype(auto) VisitElement(const Element &element, Visitor &&visitor) {
+    static_assert(Dim == 2 || Dim == 3, "Only area and volume elements can be visited");
+
+    if constexpr (Dim == 2) {
+        switch (element.VTKCellType()) {
+        case 5:
+            return std::forward<Visitor>(visitor)(static_cast<const Triangle &>(element));
+        case 22:
+            return std::forward<Visitor>(visitor)(static_cast<const TriangleOrder2 &>(element));
+        default:
+            Abort("Unsupported 2D element with VTK cell type {}", element.VTKCellType());
+        }
+    } else {
+        switch (element.VTKCellType()) {
+        case 10:
+            return std::forward<Visitor>(visitor)(static_cast<const Tetrahedron &>(element));
+        case 24:
+            return std::forward<Visitor>(visitor)(static_cast<const TetrahedronOrder2 &>(element));
+        default:
+            Abort("Unsupported 3D element with VTK cell type {}", element.VTKCellType());
+        }
+    }
+}
+
+// Sums integrand(quadrature, point) times the quadrature weights over all quadrature points. The integrand returns
+// either a Float or a fixed-size Eigen matrix, so nothing is type erased or heap allocated.
+template <Integer NumNodes, Integer Dim, Integer NumPoints, typename Integrand>
+auto Integrate(const ElementQuadrature<NumNodes, Dim, NumPoints> &quadrature, Integrand &&integrand) {
+    using Result = typename std::decay_t<decltype(integrand(quadrature, size_t{0}))>;
+
+    if constexpr (std::is_arithmetic_v<Result>) {
+        Result result = 0.0;
+        for (size_t ii = 0; ii < static_cast<size_t>(NumPoints); ++ii) {
+            result += quadrature.weights[ii] * integrand(quadrature, ii);
+        }
+
+        return result;
+    } else {
+        typename Result::PlainObject result = Result::PlainObject::Zero();
+        for (size_t ii = 0; ii < static_cast<size_t>(NumPoints); ++ii) {
+            result += quadrature.weights[ii] * integrand(quadrature, ii);
+        }
+
+        return result;
+    }
+}
+
+template <typename ElementType, typename Integrand> auto Integrate(const ElementType &element, Integrand &&integrand) {
+    return Integrate(element.EvaluateQuadrature(), std::forward<Integrand>(integrand));
+}
+
+} // namespace plasmatic
@@ -4,13 +4,14 @@
 #include "Utility/Utility.h"
 
 #include <array>
+#include <span>
 #include <vector>
 
 namespace plasmatic {
 
 class Line : public Element {
   public:
-    Line(const std::array<Integer, 2> &node_indices, std::shared_ptr<std::vector<Coord>> nodes);
+    Line(const std::array<Integer, 2> &node_indices, std::span<const Coord> nodes);
 
     virtual Integer NumNodes() const override { return 2; }
 
@@ -33,7 +34,7 @@ class Line : public Element {
 
   private:
     std::array<Integer, 2> _nodeIndices;
-    std::shared_ptr<std::vector<Coord>> _nodes;
+    std::span<const Coord> _nodes;
 };
 
 } // namespace plasmatic
@@ -4,13 +4,14 @@
 #include "Utility/Utility.h"
 
 #include <array>
+#include <span>
 #include <vector>
 
 namespace plasmatic {
 
 class LineOrder2 : public Element {
   public:
-    LineOrder2(const std::array<Integer, 3> &node_indices, std::shared_ptr<std::vector<Coord>> nodes);
+    LineOrder2(const std::array<Integer, 3> &node_indices, std::span<const Coord> nodes);
 
     virtual Integer NumNodes() const override { return 3; }
 
@@ -37,7 +38,7 @@ class LineOrder2 : public Element {
 
   private:
     std::array<Integer, 3> _nodeIndices;
-    std::shared_ptr<std::vector<Coord>> _nodes;
+    std::span<const Coord> _nodes;
 };
 
 } // namespace plasmatic
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "Adjacency.h"
 #include "Element.h"
+#include "ElementBlock.h"
 #include "Line.h"
 #include "LineOrder2.h"
 #include "Tetrahedron.h"
@@ -12,24 +14,65 @@
 
 #include <array>
 #include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace plasmatic {
 
+class GmshReader;
+
+// Numbering of the nodes (and, following them, of the elements) used while solving:
+enum class NodeOrdering {
+    Original,            // as in the Gmsh file
+    ReverseCuthillMcKee, // breadth first through the node graph, which keeps the matrix bandwidth small
+    Hilbert              // along a Hilbert curve through the node positions, which keeps neighbors close in memory
+};
+
 class Mesh {
   public:
-    Mesh(const std::filesystem::path &filename);
+    // Number of nodes or elements that one thread parses at a time:
+    static constexpr size_t default_chunk_size = 16384;
+
+    // Reads a Gmsh 4.1 file (ASCII or binary), parsing the nodes and elements on `num_threads` threads (0 means one per
+    // hardware thread) in chunks of at most `chunk_size` nodes or elements.
+    //
+    // With `use_cache` the mesh is also saved to a binary cache file next to the Gmsh file, which later runs read back
+    // instead of parsing the Gmsh file again as long as the checksum of the Gmsh file still matches:
+    Mesh(const std::filesystem::path &filename, Integer num_threads = 1, bool use_cache = false,
+         size_t chunk_size = default_chunk_size);
+
+    static std::filesystem::path CacheFilename(const std::filesystem::path &filename);
+
+    // Renumbers the nodes in the given order and sorts the elements of every block by their lowest node in the new
+    // numbering. Entities, fields and ids passed to the other methods all use the new numbering afterwards, only
+    // WriteVTK and WriteSurfaceMesh write the nodes and elements in the order of the Gmsh file again.
+    void Reorder(NodeOrdering ordering);
+
+    // Number of the node in the Gmsh file:
+    Integer GetOriginalNodeIndex(Integer index) const {
+        return _originalNodes.empty() ? index : _originalNodes[static_cast<size_t>(index)];
+    }
+
+    // Largest difference between the indices of two nodes of the same element, i.e. the half bandwidth of a matrix
+    // assembled over these elements with one unknown per node:
+    Integer GetBandwidth(Integer dimension) const;
 
     void WriteVTK(const std::filesystem::path &filename) const;
 
-    Integer GetNumNodes() const { return static_cast<Integer>(_nodes->size()); }
+    // Writes only the given elements of one dimension and the nodes they use (renumbered), without any fields:
+    void WriteVTK(const std::filesystem::path &filename, Integer dimension, std::span<const Integer> element_ids) const;
+
+    Integer GetNumNodes() const { return static_cast<Integer>(_nodes.size()); }
 
     Integer GetNumElements(Integer dimension) const {
-        return static_cast<Integer>(_elements.at(static_cast<size_t>(dimension)).size());
+        const auto &blocks = _elementBlocks.at(static_cast<size_t>(dimension));
+        return blocks.empty() ? 0 : blocks.back().first_element + blocks.back().NumElements();
     }
 
-    Coord GetNodePosition(Integer index) const { return (*_nodes)[static_cast<size_t>(index)]; }
+    Coord GetNodePosition(Integer index) const { return _nodes[static_cast<size_t>(index)]; }
 
     void AddScalarField(const std::string &field_name);
 
@@ -37,8 +80,20 @@ class Mesh {
 
     void AddTensorField(const std::string &field_name);
 
-    std::shared_ptr<Element> GetElement(Integer dimension, Integer element_id) const {
-        return _elements.at(static_cast<size_t>(dimension))[static_cast<size_t>(element_id)];
+    // The elements of one dimension, grouped into blocks of consecutive elements of the same type. Loops over the
+    // connectivity of many elements should go through the blocks rather than GetElement:
+    const std::vector<ElementBlock> &GetElementBlocks(Integer dimension) const {
+        return _elementBlocks.at(static_cast<size_t>(dimension));
+    }
+
+    std::span<const Integer> GetElementNodes(Integer dimension, Integer element_id) const {
+        const auto &block = FindElementBlock(dimension, element_id);
+        return block.ElementNodes(element_id - block.first_element);
+    }
+
+    ElementView GetElement(Integer dimension, Integer element_id) const {
+        const auto &block = FindElementBlock(dimension, element_id);
+        return {block.vtk_cell_type, block.ElementNodes(element_id - block.first_element), _nodes};
     }
 
     void ScalarFieldSetValue(const std::string &field_name, Integer index, Float value);
@@ -57,9 +112,50 @@ class Mesh {
 
     void WriteSurfaceMesh(const std::filesystem::path &base_filename) const;
 
+    // Adjacency of the elements of one dimension in CSR form. It is built on first use, on as many threads as the mesh
+    // was read with, and kept for later calls. Building isn't thread safe, so the first call for a dimension must not
+    // race with other calls.
+    //
+    // The elements of every node, in increasing order:
+    const Adjacency &GetNodeElements(Integer dimension) const;
+
+    // The nodes that share an element with every node (including the node itself), in increasing order:
+    const Adjacency &GetNodeNodes(Integer dimension) const;
+
+    // For every element, the element on the other side of each of its faces, or -1 on the boundary. Face ii is the one
+    // opposite corner node ii, as all supported elements are simplices:
+    const Adjacency &GetElementNeighbors(Integer dimension) const;
+
+    // Greedy coloring of the elements of the given dimension such that no two elements of the same color share a node,
+    // so the elements of one color can be assembled concurrently. Returns the element ids of every color.
+    std::vector<std::vector<Integer>> ColorElements(Integer dimension) const;
+
   private:
-    std::shared_ptr<std::vector<Coord>> _nodes;
-    std::array<std::vector<std::shared_ptr<Element>>, 4> _elements;
+    const ElementBlock &FindElementBlock(Integer dimension, Integer element_id) const;
+
+    void ReadGmsh(std::string_view contents, ThreadPool &pool, size_t chunk_size);
+
+    void ReadNodes(GmshReader &in, ThreadPool &pool, size_t chunk_size);
+
+    void ReadElements(GmshReader &in, ThreadPool &pool, size_t chunk_size);
+
+    // Returns false (leaving the mesh empty) if the cache is missing, of another version or of another source file:
+    bool ReadCache(const std::filesystem::path &filename, size_t source_size, uint64_t source_checksum);
+
+    void WriteCache(const std::filesystem::path &filename, size_t source_size, uint64_t source_checksum) const;
+
+    Integer _numThreads = 1;
+
+    std::vector<Coord> _nodes;
+    std::array<std::vector<ElementBlock>, 4> _elementBlocks;
+
+    // Index in the Gmsh file of every node and element, empty unless the mesh was reordered:
+    std::vector<Integer> _originalNodes;
+    std::array<std::vector<Integer>, 4> _originalElements;
+
+    mutable std::array<std::optional<Adjacency>, 4> _nodeElements;
+    mutable std::array<std::optional<Adjacency>, 4> _nodeNodes;
+    mutable std::array<std::optional<Adjacency>, 4> _elementNeighbors;
 
     std::unordered_map<std::string, std::array<std::vector<Integer>, 4>> _physicalEntities;
 
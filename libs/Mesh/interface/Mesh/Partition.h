@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Mesh.h"
+
+#include "Utility/Utility.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace plasmatic {
+
+enum class PartitionMethod { RecursiveBisection, ParMETIS };
+
+// Part of every element of one dimension of a mesh:
+struct MeshPartition {
+    Integer dimension;
+    Integer num_parts;
+    std::vector<Integer> element_parts;
+};
+
+struct PartitionStats {
+    std::vector<Integer> part_sizes;
+
+    // Largest part divided by the average part size (1 is perfectly balanced):
+    Float imbalance;
+
+    // Number of pairs of neighboring elements (sharing a face) that are in different parts:
+    Integer edge_cut;
+
+    // Number of nodes used by elements of more than one part:
+    Integer interface_nodes;
+};
+
+// Whether the ParMETIS partitioner was found when building:
+bool HasParMETIS();
+
+// Splits the elements of the given dimension into `num_parts` parts of (nearly) equal size. Recursive bisection cuts
+// the element centroids at the weighted median of the longest axis of their bounding box until there are enough
+// parts; ParMETIS partitions the dual graph of the elements instead.
+MeshPartition PartitionMesh(const Mesh &mesh, Integer dimension, Integer num_parts,
+                            PartitionMethod method = PartitionMethod::RecursiveBisection);
+
+PartitionStats ComputePartitionStats(const Mesh &mesh, const MeshPartition &partition);
+
+// Writes every part to its own file named <base_filename>_<part>.vtk:
+void WritePartitionVTK(const Mesh &mesh, const MeshPartition &partition, const std::filesystem::path &base_filename);
+
+} // namespace plasmatic
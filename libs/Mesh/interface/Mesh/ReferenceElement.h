@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Coord.h"
+#include "Utility/Utility.h"
+
+#include <Eigen/Dense>
+
+#include <array>
+#include <cmath>
+
+namespace plasmatic {
+
+// Shape functions and their parent coordinate derivatives at every quadrature point of an element type. The weights
+// include the measure of the parent element, so they sum to its area (or volume).
+template <Integer NumNodes, Integer Dim, Integer NumPoints> struct ReferenceTable {
+    std::array<std::array<Float, Dim>, NumPoints> points;
+    std::array<Float, NumPoints> weights;
+    std::array<std::array<Float, NumNodes>, NumPoints> shape_fns;
+    std::array<std::array<std::array<Float, Dim>, NumNodes>, NumPoints> shape_fn_derivatives;
+};
+
+template <Integer NumNodes, Integer Dim, Integer NumPoints, typename ShapeFnType, typename ShapeFnDerivativeType>
+constexpr ReferenceTable<NumNodes, Dim, NumPoints>
+MakeReferenceTable(const std::array<std::array<Float, Dim>, NumPoints> &points,
+                   const std::array<Float, NumPoints> &weights, ShapeFnType shape_fn,
+                   ShapeFnDerivativeType shape_fn_derivative) {
+    ReferenceTable<NumNodes, Dim, NumPoints> table = {};
+    table.points = points;
+    table.weights = weights;
+
+    for (size_t ii = 0; ii < static_cast<size_t>(NumPoints); ++ii) {
+        for (size_t jj = 0; jj < static_cast<size_t>(NumNodes); ++jj) {
+            table.shape_fns[ii][jj] = shape_fn(static_cast<Integer>(jj), points[ii]);
+            for (size_t kk = 0; kk < static_cast<size_t>(Dim); ++kk) {
+                table.shape_fn_derivatives[ii][jj][kk] =
+                    shape_fn_derivative(static_cast<Integer>(jj), static_cast<Integer>(kk), points[ii]);
+            }
+        }
+    }
+
+    return table;
+}
+
+// Physical quantities of a single element at all of the quadrature points of its reference table. The weights are the
+// reference weights scaled by the Jacobian determinant, and the shape function derivatives are with respect to the
+// physical coordinates (one row per dimension, one column per node).
+template <Integer NumNodes, Integer Dim, Integer NumPoints> struct ElementQuadrature {
+    static constexpr Integer num_nodes = NumNodes;
+    static constexpr Integer dimension = Dim;
+    static constexpr Integer num_points = NumPoints;
+
+    std::array<Coord, NumPoints> points;
+    std::array<Float, NumPoints> weights;
+    std::array<Eigen::Matrix<Float, NumNodes, 1>, NumPoints> shape_fns;
+    std::array<Eigen::Matrix<Float, Dim, NumNodes>, NumPoints> shape_fn_derivatives;
+};
+
+// Fills everything but the physical points of the quadrature from the reference table and the node coordinates
+template <Integer NumNodes, Integer Dim, Integer NumPoints>
+void EvaluateReferenceTable(const ReferenceTable<NumNodes, Dim, NumPoints> &table,
+                            const Eigen::Matrix<Float, NumNodes, Dim> &node_coords,
+                            ElementQuadrature<NumNodes, Dim, NumPoints> &quadrature) {
+    for (size_t ii = 0; ii < static_cast<size_t>(NumPoints); ++ii) {
+        Eigen::Matrix<Float, Dim, NumNodes> parent_derivatives;
+        for (Integer jj = 0; jj < NumNodes; ++jj) {
+            quadrature.shape_fns[ii](jj) = table.shape_fns[ii][static_cast<size_t>(jj)];
+            for (Integer kk = 0; kk < Dim; ++kk) {
+                parent_derivatives(kk, jj) =
+                    table.shape_fn_derivatives[ii][static_cast<size_t>(jj)][static_cast<size_t>(kk)];
+            }
+        }
+
+        const Eigen::Matrix<Float, Dim, Dim> jacobian = parent_derivatives * node_coords;
+
+        // The absolute value integrates elements of either orientation: Gmsh doesn't guarantee a positive one for
+        // surface elements, and those are mapped through their x and y coordinates:
+        quadrature.weights[ii] = table.weights[ii] * std::abs(jacobian.determinant());
+        quadrature.shape_fn_derivatives[ii] = jacobian.partialPivLu().solve(parent_derivatives);
+    }
+}
+
+} // namespace plasmatic
@@ -1,16 +1,22 @@
 #pragma once
 
 #include "Element.h"
+#include "ReferenceElement.h"
 #include "Utility/Utility.h"
 
 #include <array>
+#include <span>
 #include <vector>
 
 namespace plasmatic {
 
 class Tetrahedron : public Element {
   public:
-    Tetrahedron(const std::array<Integer, 4> &node_indices, std::shared_ptr<std::vector<Coord>> nodes);
+    using Table = ReferenceTable<4, 3, 4>;
+
+    using Quadrature = ElementQuadrature<4, 3, 4>;
+
+    Tetrahedron(const std::array<Integer, 4> &node_indices, std::span<const Coord> nodes);
 
     virtual Integer NumNodes() const override { return 4; }
 
@@ -35,9 +41,13 @@ class Tetrahedron : public Element {
 
     Coord ParentToPhysicalCoords(const std::array<Float, 3> &parent_coords) const;
 
+    static const Table &GetReferenceTable();
+
+    Quadrature EvaluateQuadrature() const;
+
   private:
     std::array<Integer, 4> _nodeIndices;
-    std::shared_ptr<std::vector<Coord>> _nodes;
+    std::span<const Coord> _nodes;
 };
 
 } // namespace plasmatic
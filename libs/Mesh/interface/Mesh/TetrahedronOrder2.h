@@ -1,16 +1,22 @@
 #pragma once
 
 #include "Element.h"
+#include "ReferenceElement.h"
 #include "Utility/Utility.h"
 
 #include <array>
+#include <span>
 #include <vector>
 
 namespace plasmatic {
 
 class TetrahedronOrder2 : public Element {
   public:
-    TetrahedronOrder2(const std::array<Integer, 10> &node_indices, std::shared_ptr<std::vector<Coord>> nodes);
+    using Table = ReferenceTable<10, 3, 4>;
+
+    using Quadrature = ElementQuadrature<10, 3, 4>;
+
+    TetrahedronOrder2(const std::array<Integer, 10> &node_indices, std::span<const Coord> nodes);
 
     virtual Integer NumNodes() const override { return 10; }
 
@@ -35,9 +41,13 @@ class TetrahedronOrder2 : public Element {
 
     Coord ParentToPhysicalCoords(const std::array<Float, 3> &parent_coords) const;
 
+    static const Table &GetReferenceTable();
+
+    Quadrature EvaluateQuadrature() const;
+
   private:
     std::array<Integer, 10> _nodeIndices;
-    std::shared_ptr<std::vector<Coord>> _nodes;
+    std::span<const Coord> _nodes;
 };
 
 } // namespace plasmatic
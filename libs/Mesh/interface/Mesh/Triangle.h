@@ -1,16 +1,22 @@
 #pragma once
 
 #include "Element.h"
+#include "ReferenceElement.h"
 #include "Utility/Utility.h"
 
 #include <array>
+#include <span>
 #include <vector>
 
 namespace plasmatic {
 
 class Triangle : public Element {
   public:
-    Triangle(const std::array<Integer, 3> &node_indices, std::shared_ptr<std::vector<Coord>> nodes);
+    using Table = ReferenceTable<3, 2, 1>;
+
+    using Quadrature = ElementQuadrature<3, 2, 1>;
+
+    Triangle(const std::array<Integer, 3> &node_indices, std::span<const Coord> nodes);
 
     virtual Integer NumNodes() const override { return 3; }
 
@@ -35,9 +41,13 @@ class Triangle : public Element {
 
     Coord ParentToPhysicalCoords(const std::array<Float, 2> &parent_coords) const;
 
+    static const Table &GetReferenceTable();
+
+    Quadrature EvaluateQuadrature() const;
+
   private:
     std::array<Integer, 3> _nodeIndices;
-    std::shared_ptr<std::vector<Coord>> _nodes;
+    std::span<const Coord> _nodes;
 };
 
 } // namespace plasmatic
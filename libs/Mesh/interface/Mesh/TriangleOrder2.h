@@ -1,16 +1,22 @@
 #pragma once
 
 #include "Element.h"
+#include "ReferenceElement.h"
 #include "Utility/Utility.h"
 
 #include <array>
+#include <span>
 #include <vector>
 
 namespace plasmatic {
 
 class TriangleOrder2 : public Element {
   public:
-    TriangleOrder2(const std::array<Integer, 6> &node_indices, std::shared_ptr<std::vector<Coord>> nodes);
+    using Table = ReferenceTable<6, 2, 3>;
+
+    using Quadrature = ElementQuadrature<6, 2, 3>;
+
+    TriangleOrder2(const std::array<Integer, 6> &node_indices, std::span<const Coord> nodes);
 
     virtual Integer NumNodes() const override { return 6; }
 
@@ -35,9 +41,13 @@ class TriangleOrder2 : public Element {
 
     Coord ParentToPhysicalCoords(const std::array<Float, 2> &parent_coords) const;
 
+    static const Table &GetReferenceTable();
+
+    Quadrature EvaluateQuadrature() const;
+
   private:
     std::array<Integer, 6> _nodeIndices;
-    std::shared_ptr<std::vector<Coord>> _nodes;
+    std::span<const Coord> _nodes;
 };
 
 } // namespace plasmatic
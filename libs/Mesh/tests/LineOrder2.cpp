@@ -10,7 +10,7 @@ TEST(MeshTest, LineOrder2) {
     nodes->push_back({.x = 1.0, .y = 0.0, .z = 0.0});
     nodes->push_back({.x = 0.5, .y = 0.0, .z = 0.0});
 
-    LineOrder2 line({0, 1, 2}, nodes);
+    LineOrder2 line({0, 1, 2}, *nodes);
 
     for (Integer ii = 0; ii < static_cast<Integer>(nodes->size()); ++ii) {
         EXPECT_DOUBLE_EQ(line.ShapeFn(ii, (*nodes)[static_cast<size_t>(ii)]), 1.0) << ", ii = " << ii;
@@ -50,7 +50,7 @@ TEST(MeshTest, LineOrder2ShapeFnDerivatives) {
     nodes->push_back({.x = 1.0, .y = 0.0, .z = 0.0});
     nodes->push_back({.x = 0.5, .y = 0.0, .z = 0.0});
 
-    LineOrder2 line({0, 1, 2}, nodes);
+    LineOrder2 line({0, 1, 2}, *nodes);
 
     for (Integer ii = 0; ii < static_cast<Integer>(nodes->size()); ++ii) {
         constexpr auto eps = 1.0e-8;
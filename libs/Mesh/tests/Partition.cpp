@@ -0,0 +1,52 @@
+#include "Mesh/Partition.h"
+
+#include <gtest/gtest.h>
+
+namespace plasmatic {
+TEST(MeshTest, PartitionRecursiveBisection) {
+    auto filename = GetExecutablePath() / "assets/Mesh/mesh2d.msh";
+    Mesh mesh(filename);
+
+    constexpr Integer dimension = 2;
+    constexpr Integer num_parts = 4;
+    auto partition = PartitionMesh(mesh, dimension, num_parts);
+
+    EXPECT_EQ(partition.dimension, dimension);
+    EXPECT_EQ(partition.num_parts, num_parts);
+    ASSERT_EQ(static_cast<Integer>(partition.element_parts.size()), mesh.GetNumElements(dimension));
+
+    for (const auto &part : partition.element_parts) {
+        EXPECT_GE(part, 0);
+        EXPECT_LT(part, num_parts);
+    }
+
+    // 12 elements split into 4 parts of 3 elements each:
+    auto stats = ComputePartitionStats(mesh, partition);
+    for (const auto &part_size : stats.part_sizes) {
+        EXPECT_EQ(part_size, 3);
+    }
+
+    EXPECT_DOUBLE_EQ(stats.imbalance, 1.0);
+    EXPECT_GT(stats.edge_cut, 0);
+    EXPECT_GT(stats.interface_nodes, 0);
+
+    WritePartitionVTK(mesh, partition, "mesh2d_partition");
+    for (Integer ii = 0; ii < num_parts; ++ii) {
+        EXPECT_TRUE(std::filesystem::exists("mesh2d_partition_" + std::to_string(ii) + ".vtk"));
+    }
+}
+
+TEST(MeshTest, PartitionSinglePart) {
+    auto filename = GetExecutablePath() / "assets/Mesh/mesh2d.msh";
+    Mesh mesh(filename);
+
+    auto partition = PartitionMesh(mesh, 2, 1);
+    auto stats = ComputePartitionStats(mesh, partition);
+
+    ASSERT_EQ(stats.part_sizes.size(), 1);
+    EXPECT_EQ(stats.part_sizes[0], mesh.GetNumElements(2));
+    EXPECT_DOUBLE_EQ(stats.imbalance, 1.0);
+    EXPECT_EQ(stats.edge_cut, 0);
+    EXPECT_EQ(stats.interface_nodes, 0);
+}
+} // namespace plasmatic
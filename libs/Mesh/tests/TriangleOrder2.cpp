@@ -13,7 +13,7 @@ TEST(MeshTest, TriangleOrder2) {
     nodes->push_back({.x = 0.5, .y = 0.5, .z = 0.0});
     nodes->push_back({.x = 0.0, .y = 0.5, .z = 0.0});
 
-    TriangleOrder2 tri({0, 1, 2, 3, 4, 5}, nodes);
+    TriangleOrder2 tri({0, 1, 2, 3, 4, 5}, *nodes);
 
     for (Integer ii = 0; ii < static_cast<Integer>(nodes->size()); ++ii) {
         EXPECT_DOUBLE_EQ(tri.ShapeFn(ii, (*nodes)[static_cast<size_t>(ii)]), 1.0) << ", ii = " << ii;
@@ -56,7 +56,7 @@ TEST(MeshTest, TriangleOrder2ShapeFnDerivatives) {
     nodes->push_back({.x = 0.5, .y = 0.5, .z = 0.0});
     nodes->push_back({.x = 0.0, .y = 0.5, .z = 0.0});
 
-    TriangleOrder2 tri({0, 1, 2, 3, 4, 5}, nodes);
+    TriangleOrder2 tri({0, 1, 2, 3, 4, 5}, *nodes);
 
     for (Integer ii = 0; ii < static_cast<Integer>(nodes->size()); ++ii) {
         constexpr auto eps = 1.0e-8;
@@ -82,4 +82,57 @@ TEST(MeshTest, TriangleOrder2ShapeFnDerivatives) {
     }
 }
 
+TEST(MeshTest, TriangleOrder2Quadrature) {
+    const auto &table = TriangleOrder2::GetReferenceTable();
+
+    Float total_weight = 0.0;
+    for (size_t ii = 0; ii < table.points.size(); ++ii) {
+        total_weight += table.weights[ii];
+
+        Float shape_fn_sum = 0.0;
+        std::array<Float, 2> derivative_sum = {};
+        for (size_t jj = 0; jj < table.shape_fns[ii].size(); ++jj) {
+            shape_fn_sum += table.shape_fns[ii][jj];
+            for (size_t kk = 0; kk < derivative_sum.size(); ++kk) {
+                derivative_sum[kk] += table.shape_fn_derivatives[ii][jj][kk];
+            }
+        }
+
+        EXPECT_NEAR(shape_fn_sum, 1.0, 1.0e-12);
+        for (const auto &value : derivative_sum) {
+            EXPECT_NEAR(value, 0.0, 1.0e-12);
+        }
+    }
+    EXPECT_NEAR(total_weight, 0.5, 1.0e-12);
+
+    auto nodes = std::make_shared<std::vector<Coord>>();
+
+    nodes->push_back({.x = 0.0, .y = 0.0, .z = 0.0});
+    nodes->push_back({.x = 2.0, .y = 0.5, .z = 0.0});
+    nodes->push_back({.x = 0.5, .y = 1.5, .z = 0.0});
+
+    nodes->push_back({.x = 1.0, .y = 0.25, .z = 0.0});
+    nodes->push_back({.x = 1.25, .y = 1.0, .z = 0.0});
+    nodes->push_back({.x = 0.25, .y = 0.75, .z = 0.0});
+
+    TriangleOrder2 tri({0, 1, 2, 3, 4, 5}, *nodes);
+
+    const auto quadrature = tri.EvaluateQuadrature();
+
+    Float area = 0.0;
+    for (size_t ii = 0; ii < quadrature.points.size(); ++ii) {
+        area += quadrature.weights[ii];
+
+        for (Integer jj = 0; jj < tri.NumNodes(); ++jj) {
+            EXPECT_NEAR(quadrature.shape_fns[ii](jj), tri.ShapeFn(jj, quadrature.points[ii]), 1.0e-12);
+            for (Integer kk = 0; kk < 2; ++kk) {
+                EXPECT_NEAR(quadrature.shape_fn_derivatives[ii](kk, jj),
+                            tri.ShapeFnDerivative(jj, kk, quadrature.points[ii]), 1.0e-10);
+            }
+        }
+    }
+
+    EXPECT_NEAR(area, TriangleOrder2::ComputeArea((*nodes)[0], (*nodes)[1], (*nodes)[2]), 1.0e-12);
+}
+
 } // namespace plasmatic
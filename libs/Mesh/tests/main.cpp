@@ -2,6 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <fstream>
+#include <string>
+
 namespace plasmatic {
 TEST(MeshTest, Simple) {
     auto filename = GetExecutablePath() / "assets/Mesh/mesh2d.msh";
@@ -14,6 +18,317 @@ TEST(MeshTest, Simple) {
     mesh.WriteVTK("mesh2d.vtk");
 }
 
+namespace {
+void ExpectSameMesh(const Mesh &mesh, const Mesh &expected) {
+    ASSERT_EQ(mesh.GetNumNodes(), expected.GetNumNodes());
+    for (Integer ii = 0; ii < expected.GetNumNodes(); ++ii) {
+        EXPECT_DOUBLE_EQ(mesh.GetNodePosition(ii).x, expected.GetNodePosition(ii).x);
+        EXPECT_DOUBLE_EQ(mesh.GetNodePosition(ii).y, expected.GetNodePosition(ii).y);
+        EXPECT_DOUBLE_EQ(mesh.GetNodePosition(ii).z, expected.GetNodePosition(ii).z);
+    }
+
+    for (Integer dimension = 0; dimension <= 3; ++dimension) {
+        ASSERT_EQ(mesh.GetNumElements(dimension), expected.GetNumElements(dimension));
+        for (Integer ii = 0; ii < expected.GetNumElements(dimension); ++ii) {
+            auto element = mesh.GetElement(dimension, ii);
+            auto expected_element = expected.GetElement(dimension, ii);
+
+            EXPECT_EQ(element->VTKCellType(), expected_element->VTKCellType());
+            ASSERT_EQ(element->NumNodes(), expected_element->NumNodes());
+            for (Integer jj = 0; jj < expected_element->NumNodes(); ++jj) {
+                EXPECT_EQ(element->GetNodeIndex(jj), expected_element->GetNodeIndex(jj));
+            }
+        }
+    }
+
+    for (const auto &name : {"My curve 1", "My curve 2", "My surface"}) {
+        for (Integer dimension = 1; dimension <= 2; ++dimension) {
+            EXPECT_EQ(mesh.GetPhysicalEntity(name, dimension), expected.GetPhysicalEntity(name, dimension));
+        }
+    }
+
+    EXPECT_EQ(mesh.GetEntity(2, 1), expected.GetEntity(2, 1));
+}
+} // namespace
+
+TEST(MeshTest, Binary) {
+    Mesh ascii_mesh(GetExecutablePath() / "assets/Mesh/mesh2d.msh");
+    Mesh binary_mesh(GetExecutablePath() / "assets/Mesh/mesh2d_binary.msh");
+
+    ExpectSameMesh(binary_mesh, ascii_mesh);
+}
+
+TEST(MeshTest, Binary_big_endian) {
+    Mesh ascii_mesh(GetExecutablePath() / "assets/Mesh/mesh2d.msh");
+    Mesh binary_mesh(GetExecutablePath() / "assets/Mesh/mesh2d_binary_big_endian.msh");
+
+    ExpectSameMesh(binary_mesh, ascii_mesh);
+}
+
+TEST(MeshTest, Binary_4_byte_size_t) {
+    Mesh ascii_mesh(GetExecutablePath() / "assets/Mesh/mesh2d.msh");
+    Mesh binary_mesh(GetExecutablePath() / "assets/Mesh/mesh2d_binary_size4.msh");
+
+    ExpectSameMesh(binary_mesh, ascii_mesh);
+}
+
+TEST(MeshTest, Chunks) {
+    for (const auto *name : {"mesh2d.msh", "mesh2d_binary.msh"}) {
+        const auto filename = GetExecutablePath() / "assets/Mesh" / name;
+        Mesh serial_mesh(filename);
+
+        // Chunks of a few nodes or elements split every block, including in the middle of the ones that don't divide
+        // evenly:
+        for (const auto num_threads : {1, 3}) {
+            for (const size_t chunk_size : {1, 2, 5}) {
+                SCOPED_TRACE(std::string(name) + ", " + std::to_string(num_threads) + " threads, chunks of " +
+                             std::to_string(chunk_size));
+
+                Mesh mesh(filename, num_threads, false, chunk_size);
+                ExpectSameMesh(mesh, serial_mesh);
+            }
+        }
+    }
+}
+
+TEST(MeshTest, Cache) {
+    const std::filesystem::path filename = "mesh2d_cached.msh";
+    const auto cache_filename = Mesh::CacheFilename(filename);
+
+    std::filesystem::copy_file(GetExecutablePath() / "assets/Mesh/mesh2d.msh", filename,
+                               std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::remove(cache_filename);
+
+    Mesh mesh(filename);
+
+    // The first read writes the cache, the second one reads it:
+    Mesh first_mesh(filename, 1, true);
+    ASSERT_TRUE(std::filesystem::exists(cache_filename));
+    ExpectSameMesh(first_mesh, mesh);
+
+    Mesh cached_mesh(filename, 1, true);
+    ExpectSameMesh(cached_mesh, mesh);
+
+    // A changed mesh file makes the cache stale, so it is read and cached again:
+    {
+        std::ofstream out(filename, std::ios::app);
+        out << "$Comments" << std::endl << "$EndComments" << std::endl;
+    }
+
+    const auto cache_size = std::filesystem::file_size(cache_filename);
+    std::filesystem::resize_file(cache_filename, cache_size / 2);
+
+    Mesh changed_mesh(filename, 1, true);
+    ExpectSameMesh(changed_mesh, mesh);
+    EXPECT_EQ(std::filesystem::file_size(cache_filename), cache_size);
+
+    // A truncated cache of the right file is ignored as well:
+    std::filesystem::resize_file(cache_filename, cache_size - 1);
+
+    Mesh truncated_mesh(filename, 1, true);
+    ExpectSameMesh(truncated_mesh, mesh);
+}
+
+TEST(MeshTest, ElementBlocks) {
+    Mesh mesh(GetExecutablePath() / "assets/Mesh/mesh2d.msh");
+
+    for (Integer dimension = 0; dimension <= 3; ++dimension) {
+        Integer num_elements = 0;
+        for (const auto &block : mesh.GetElementBlocks(dimension)) {
+            EXPECT_EQ(block.first_element, num_elements);
+            EXPECT_EQ(block.nodes_per_element, VTKCellTypeNumNodes(block.vtk_cell_type));
+            num_elements += block.NumElements();
+
+            // The views see the same connectivity as the blocks:
+            for (Integer ii = 0; ii < block.NumElements(); ++ii) {
+                const auto element_id = block.first_element + ii;
+                const auto element_nodes = block.ElementNodes(ii);
+                auto element = mesh.GetElement(dimension, element_id);
+
+                EXPECT_EQ(element->VTKCellType(), block.vtk_cell_type);
+                ASSERT_EQ(element->NumNodes(), block.nodes_per_element);
+                for (Integer jj = 0; jj < element->NumNodes(); ++jj) {
+                    EXPECT_EQ(element->GetNodeIndex(jj), element_nodes[static_cast<size_t>(jj)]);
+                    EXPECT_EQ(mesh.GetElementNodes(dimension, element_id)[static_cast<size_t>(jj)],
+                              element_nodes[static_cast<size_t>(jj)]);
+                }
+            }
+        }
+
+        EXPECT_EQ(num_elements, mesh.GetNumElements(dimension));
+    }
+
+    // Every dimension of this mesh has a single element type, so a single block:
+    EXPECT_EQ(mesh.GetElementBlocks(1).size(), 1);
+    EXPECT_EQ(mesh.GetElementBlocks(2).size(), 1);
+}
+
+TEST(MeshTest, Adjacency) {
+    constexpr Integer dimension = 2;
+
+    for (const auto num_threads : {1, 3}) {
+        Mesh mesh(GetExecutablePath() / "assets/Mesh/mesh2d.msh", num_threads);
+        const auto num_nodes = mesh.GetNumNodes();
+        const auto num_elements = mesh.GetNumElements(dimension);
+
+        // Compare with the adjacency found by brute force:
+        const auto &node_elements = mesh.GetNodeElements(dimension);
+        const auto &node_nodes = mesh.GetNodeNodes(dimension);
+        ASSERT_EQ(node_elements.NumItems(), num_nodes);
+        ASSERT_EQ(node_nodes.NumItems(), num_nodes);
+
+        for (Integer node = 0; node < num_nodes; ++node) {
+            std::vector<Integer> expected_elements;
+            std::vector<Integer> expected_nodes = {node};
+            for (Integer element_id = 0; element_id < num_elements; ++element_id) {
+                const auto element_nodes = mesh.GetElementNodes(dimension, element_id);
+                if (std::find(element_nodes.begin(), element_nodes.end(), node) != element_nodes.end()) {
+                    expected_elements.push_back(element_id);
+                    expected_nodes.insert(expected_nodes.end(), element_nodes.begin(), element_nodes.end());
+                }
+            }
+
+            std::sort(expected_nodes.begin(), expected_nodes.end());
+            expected_nodes.erase(std::unique(expected_nodes.begin(), expected_nodes.end()), expected_nodes.end());
+
+            const auto elements = node_elements.Neighbors(node);
+            const auto nodes = node_nodes.Neighbors(node);
+            EXPECT_EQ(std::vector<Integer>(elements.begin(), elements.end()), expected_elements);
+            EXPECT_EQ(std::vector<Integer>(nodes.begin(), nodes.end()), expected_nodes);
+        }
+
+        // Triangles are neighbors across an edge if they share two nodes, and the edge opposite corner ii is the one
+        // without that corner:
+        const auto &element_neighbors = mesh.GetElementNeighbors(dimension);
+        ASSERT_EQ(element_neighbors.NumItems(), num_elements);
+
+        Integer num_boundary_faces = 0;
+        for (Integer element_id = 0; element_id < num_elements; ++element_id) {
+            const auto corners = mesh.GetElementNodes(dimension, element_id);
+            const auto neighbors = element_neighbors.Neighbors(element_id);
+            ASSERT_EQ(neighbors.size(), 3);
+
+            for (size_t face = 0; face < neighbors.size(); ++face) {
+                Integer expected_neighbor = -1;
+                for (Integer other_id = 0; other_id < num_elements; ++other_id) {
+                    const auto other_nodes = mesh.GetElementNodes(dimension, other_id);
+                    const auto shared = std::count_if(other_nodes.begin(), other_nodes.end(), [&](Integer node) {
+                        return node != corners[face] &&
+                               std::find(corners.begin(), corners.end(), node) != corners.end();
+                    });
+                    if (other_id != element_id && shared == 2) {
+                        expected_neighbor = other_id;
+                    }
+                }
+
+                EXPECT_EQ(neighbors[face], expected_neighbor);
+                num_boundary_faces += neighbors[face] < 0 ? 1 : 0;
+            }
+        }
+
+        // The boundary of the mesh is made of the line elements:
+        EXPECT_EQ(num_boundary_faces, mesh.GetNumElements(1));
+    }
+}
+
+TEST(MeshTest, ColorElements) {
+    auto filename = GetExecutablePath() / "assets/Mesh/mesh2d.msh";
+    Mesh mesh(filename);
+
+    constexpr Integer dimension = 2;
+    auto colors = mesh.ColorElements(dimension);
+
+    // Every element has exactly one color, and elements of the same color never share a node:
+    std::vector<Integer> element_counts(static_cast<size_t>(mesh.GetNumElements(dimension)), 0);
+    for (const auto &color : colors) {
+        EXPECT_FALSE(color.empty());
+
+        std::vector<Integer> node_counts(static_cast<size_t>(mesh.GetNumNodes()), 0);
+        for (const auto &element_id : color) {
+            element_counts[static_cast<size_t>(element_id)]++;
+
+            for (const auto &node : mesh.GetElementNodes(dimension, element_id)) {
+                node_counts[static_cast<size_t>(node)]++;
+            }
+        }
+
+        for (const auto &count : node_counts) {
+            EXPECT_LE(count, 1);
+        }
+    }
+
+    for (const auto &count : element_counts) {
+        EXPECT_EQ(count, 1);
+    }
+
+    // Some elements share a node, so one color is not enough:
+    EXPECT_GT(colors.size(), 1);
+}
+
+TEST(MeshTest, Reorder) {
+    constexpr Integer dimension = 2;
+    const auto filename = GetExecutablePath() / "assets/Mesh/mesh2d.msh";
+
+    const auto read_file = [](const std::filesystem::path &path) {
+        std::ifstream in(path);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    Mesh original(filename);
+    original.AddScalarField("x");
+    for (Integer ii = 0; ii < original.GetNumNodes(); ++ii) {
+        original.ScalarFieldSetValue("x", ii, original.GetNodePosition(ii).x);
+    }
+    original.WriteVTK("mesh2d_original.vtk");
+
+    for (const auto ordering : {NodeOrdering::ReverseCuthillMcKee, NodeOrdering::Hilbert}) {
+        Mesh mesh(filename);
+        mesh.AddScalarField("x");
+        mesh.Reorder(ordering);
+
+        ASSERT_EQ(mesh.GetNumNodes(), original.GetNumNodes());
+        ASSERT_EQ(mesh.GetNumElements(dimension), original.GetNumElements(dimension));
+        if (ordering == NodeOrdering::ReverseCuthillMcKee) {
+            EXPECT_LE(mesh.GetBandwidth(dimension), original.GetBandwidth(dimension));
+        }
+
+        // Every node moved along with its position, and the nodes of the entities moved with them:
+        std::vector<Integer> original_nodes;
+        for (Integer ii = 0; ii < mesh.GetNumNodes(); ++ii) {
+            const auto original_node = mesh.GetOriginalNodeIndex(ii);
+            EXPECT_EQ(mesh.GetNodePosition(ii).x, original.GetNodePosition(original_node).x);
+            EXPECT_EQ(mesh.GetNodePosition(ii).y, original.GetNodePosition(original_node).y);
+            original_nodes.push_back(original_node);
+        }
+        std::sort(original_nodes.begin(), original_nodes.end());
+        EXPECT_EQ(std::adjacent_find(original_nodes.begin(), original_nodes.end()), original_nodes.end());
+
+        for (Integer entity_id = 1; entity_id <= 4; ++entity_id) {
+            std::vector<Integer> entity_nodes;
+            for (const auto &node : mesh.GetEntity(0, entity_id)) {
+                entity_nodes.push_back(mesh.GetOriginalNodeIndex(node));
+            }
+            std::sort(entity_nodes.begin(), entity_nodes.end());
+            EXPECT_EQ(entity_nodes, original.GetEntity(0, entity_id));
+        }
+
+        // The output is in the original order again, fields included:
+        for (Integer ii = 0; ii < mesh.GetNumNodes(); ++ii) {
+            mesh.ScalarFieldSetValue("x", ii, mesh.GetNodePosition(ii).x);
+        }
+        mesh.WriteVTK("mesh2d_reordered.vtk");
+        EXPECT_EQ(read_file("mesh2d_reordered.vtk"), read_file("mesh2d_original.vtk"));
+
+        // The adjacency follows the new numbering:
+        for (Integer element_id = 0; element_id < mesh.GetNumElements(dimension); ++element_id) {
+            for (const auto &node : mesh.GetElementNodes(dimension, element_id)) {
+                const auto elements = mesh.GetNodeElements(dimension).Neighbors(node);
+                EXPECT_NE(std::find(elements.begin(), elements.end(), element_id), elements.end());
+            }
+        }
+    }
+}
+
 TEST(MeshTest, Triangle) {
     auto nodes = std::make_shared<std::vector<Coord>>();
 
@@ -21,7 +336,7 @@ TEST(MeshTest, Triangle) {
     nodes->push_back({.x = 1.0, .y = 0.0, .z = 0.0});
     nodes->push_back({.x = 0.0, .y = 1.0, .z = 0.0});
 
-    Triangle tri({0, 1, 2}, nodes);
+    Triangle tri({0, 1, 2}, *nodes);
 
     for (Integer ii = 0; ii < 3; ++ii) {
         EXPECT_DOUBLE_EQ(tri.ShapeFn(ii, (*nodes)[static_cast<size_t>(ii)]), 1.0) << ", ii = " << ii;
@@ -62,7 +377,7 @@ TEST(MeshTest, TriangleShapeFnDerivatives) {
     nodes->push_back({.x = 0.0, .y = 1.0, .z = 0.0});
 
     for (Integer ii = 0; ii < 3; ++ii) {
-        Triangle tri({(0 + ii) % 3, (1 + ii) % 3, (2 + ii) % 3}, nodes);
+        Triangle tri({(0 + ii) % 3, (1 + ii) % 3, (2 + ii) % 3}, *nodes);
 
         EXPECT_DOUBLE_EQ(tri.ShapeFnDerivative((3 - ii) % 3, 0, {.x = 0.0, .y = 0.0, .z = 0.0}), -1.0) << "ii = " << ii;
         EXPECT_DOUBLE_EQ(tri.ShapeFnDerivative((3 - ii) % 3, 1, {.x = 0.0, .y = 0.0, .z = 0.0}), -1.0) << "ii = " << ii;
@@ -80,7 +395,7 @@ TEST(MeshTest, Tetrahedron) {
     nodes->push_back({.x = 0.0, .y = 1.0, .z = 0.0});
     nodes->push_back({.x = 0.0, .y = 0.0, .z = 1.0});
 
-    Tetrahedron tet({0, 1, 2, 3}, nodes);
+    Tetrahedron tet({0, 1, 2, 3}, *nodes);
 
     for (Integer ii = 0; ii < 4; ++ii) {
         EXPECT_DOUBLE_EQ(tet.ShapeFn(ii, (*nodes)[static_cast<size_t>(ii)]), 1.0) << ", ii = " << ii;
@@ -122,7 +437,7 @@ TEST(MeshTest, TetrahedronShapeFnDerivatives) {
     nodes->push_back({.x = 0.0, .y = 0.0, .z = 1.0});
 
     for (Integer ii = 0; ii < 4; ++ii) {
-        Tetrahedron tet({(0 + ii) % 4, (1 + ii) % 4, (2 + ii) % 4, (3 + ii) % 4}, nodes);
+        Tetrahedron tet({(0 + ii) % 4, (1 + ii) % 4, (2 + ii) % 4, (3 + ii) % 4}, *nodes);
 
         EXPECT_DOUBLE_EQ(tet.ShapeFnDerivative((4 - ii) % 4, 0, {.x = 0.0, .y = 0.0, .z = 0.0}), -1.0) << "ii = " << ii;
         EXPECT_DOUBLE_EQ(tet.ShapeFnDerivative((4 - ii) % 4, 1, {.x = 0.0, .y = 0.0, .z = 0.0}), -1.0) << "ii = " << ii;
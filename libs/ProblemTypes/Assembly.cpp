@@ -0,0 +1,287 @@
+#include "interface/ProblemTypes/Assembly.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <span>
+
+namespace plasmatic {
+
+namespace {
+
+// The rows [begin, end) of the node graph of the mesh:
+Adjacency NodeGraphRows(const Adjacency &node_nodes, Integer begin, Integer end) {
+    const auto neighbors_begin = node_nodes.offsets[static_cast<size_t>(begin)];
+    const auto neighbors_end = node_nodes.offsets[static_cast<size_t>(end)];
+
+    Adjacency graph;
+    graph.offsets.reserve(static_cast<size_t>(end - begin) + 1);
+    for (auto row = begin; row <= end; ++row) {
+        graph.offsets.push_back(node_nodes.offsets[static_cast<size_t>(row)] - neighbors_begin);
+    }
+    graph.neighbors.assign(node_nodes.neighbors.begin() + neighbors_begin,
+                           node_nodes.neighbors.begin() + neighbors_end);
+
+    return graph;
+}
+
+// Sorted, unique neighbors of a list of nodes (the rows) in CSR form, through the given elements only. Every row is its
+// own neighbor so that every row has a diagonal entry.
+Adjacency BuildNodeGraph(const Mesh &mesh, Integer dimension, const std::vector<bool> &use_element,
+                         std::span<const Integer> rows) {
+    const auto &node_elements = mesh.GetNodeElements(dimension);
+
+    Adjacency graph;
+    graph.offsets.reserve(rows.size() + 1);
+    graph.offsets.push_back(0);
+
+    std::vector<Integer> neighbors;
+    for (const auto &row : rows) {
+        neighbors.clear();
+        neighbors.push_back(row);
+        for (const auto &element_id : node_elements.Neighbors(row)) {
+            if (use_element[static_cast<size_t>(element_id)]) {
+                const auto element_nodes = mesh.GetElementNodes(dimension, element_id);
+                neighbors.insert(neighbors.end(), element_nodes.begin(), element_nodes.end());
+            }
+        }
+
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+        graph.neighbors.insert(graph.neighbors.end(), neighbors.begin(), neighbors.end());
+        graph.offsets.push_back(static_cast<Integer>(graph.neighbors.size()));
+    }
+
+    return graph;
+}
+
+std::vector<Integer> Range(Integer begin, Integer end) {
+    std::vector<Integer> range(static_cast<size_t>(end - begin));
+    std::iota(range.begin(), range.end(), begin);
+
+    return range;
+}
+
+// Expects the graph of the owned rows of the pattern:
+void SetNonzeros(const Adjacency &graph, SparsityPattern &pattern) {
+    const auto node_start = pattern.BlockRowStart();
+    const auto node_end = pattern.BlockRowEnd();
+
+    for (Integer node = node_start; node < node_end; ++node) {
+        const auto local_node = static_cast<size_t>(node - node_start);
+        const auto begin = graph.neighbors.begin() + graph.offsets[local_node];
+        const auto end = graph.neighbors.begin() + graph.offsets[local_node + 1];
+
+        // Neighbors are sorted, so the owned (diagonal) columns are a contiguous range and the upper triangle (used by
+        // symmetric storage) is everything from the node onwards:
+        const auto diagonal_begin = std::lower_bound(begin, end, node_start);
+        const auto diagonal_end = std::lower_bound(diagonal_begin, end, node_end);
+        const auto diagonal = static_cast<Integer>(diagonal_end - diagonal_begin);
+
+        pattern.SetBlockRowNonzeros(node, diagonal, static_cast<Integer>(end - begin) - diagonal);
+
+        const auto upper_begin = std::lower_bound(diagonal_begin, diagonal_end, node);
+        pattern.SetUpperBlockRowNonzeros(node, static_cast<Integer>(diagonal_end - upper_begin),
+                                         static_cast<Integer>(end - diagonal_end));
+    }
+}
+
+constexpr Integer max_nodes_per_element = 32;
+
+// Upper bound on the number of elements a thread grabs at once (small colors are split into a few chunks per thread):
+constexpr Integer max_elements_per_chunk = 64;
+
+} // namespace
+
+SparsityPattern BuildSparsityPattern(const Mesh &mesh, Integer dimension, Integer dofs_per_node) {
+    SparsityPattern pattern(dofs_per_node * mesh.GetNumNodes(), dofs_per_node);
+
+    SetNonzeros(NodeGraphRows(mesh.GetNodeNodes(dimension), pattern.BlockRowStart(), pattern.BlockRowEnd()), pattern);
+
+    return pattern;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+ElementAssembler::ElementAssembler(const Mesh &mesh, Integer dimension, Integer dofs_per_node, Integer num_threads)
+    : _mesh(mesh), _dimension(dimension), _dofsPerNode(dofs_per_node),
+      _rank(CommRank()), _pattern(dofs_per_node * mesh.GetNumNodes(), dofs_per_node),
+      _pool(num_threads > 0 ? num_threads : ThreadPool::HardwareThreads()) {
+    // The pattern of the owned rows has to include the elements of other ranks that touch them:
+    const auto element_ids = Range(0, mesh.GetNumElements(dimension));
+    auto owned_rows = Range(_pattern.BlockRowStart(), _pattern.BlockRowEnd());
+    auto graph = NodeGraphRows(mesh.GetNodeNodes(dimension), _pattern.BlockRowStart(), _pattern.BlockRowEnd());
+    SetNonzeros(graph, _pattern);
+
+    std::vector<bool> is_owned(element_ids.size(), false);
+    for (const auto &element_id : element_ids) {
+        if (OwnsElement(*mesh.GetElement(dimension, element_id))) {
+            _ownedElements.push_back(element_id);
+            is_owned[static_cast<size_t>(element_id)] = true;
+        }
+    }
+
+    _elementMatrices.resize(static_cast<size_t>(_pool.NumThreads()));
+
+    // Serial assembly goes straight into the matrix and doesn't need the colors or a copy of the rows:
+    if (_pool.NumThreads() == 1) {
+        return;
+    }
+
+    for (auto &color : mesh.ColorElements(dimension)) {
+        std::erase_if(color, [&is_owned](Integer element_id) { return !is_owned[static_cast<size_t>(element_id)]; });
+        if (!color.empty()) {
+            _colors.push_back(std::move(color));
+        }
+    }
+
+    // The owned elements also add to rows of other ranks (ghost rows), which are sent to their owners by the matrix:
+    std::vector<Integer> ghost_rows;
+    for (const auto &element_id : _ownedElements) {
+        for (const auto &node : mesh.GetElementNodes(dimension, element_id)) {
+            if (!_pattern.OwnsBlockRow(node)) {
+                ghost_rows.push_back(node);
+            }
+        }
+    }
+
+    std::sort(ghost_rows.begin(), ghost_rows.end());
+    ghost_rows.erase(std::unique(ghost_rows.begin(), ghost_rows.end()), ghost_rows.end());
+
+    auto ghost_graph = BuildNodeGraph(mesh, dimension, is_owned, ghost_rows);
+
+    _rows = std::move(owned_rows);
+    _rows.insert(_rows.end(), ghost_rows.begin(), ghost_rows.end());
+
+    _rowOffsets = std::move(graph.offsets);
+    const auto num_owned_columns = static_cast<Integer>(graph.neighbors.size());
+    for (size_t ii = 1; ii < ghost_graph.offsets.size(); ++ii) {
+        _rowOffsets.push_back(num_owned_columns + ghost_graph.offsets[ii]);
+    }
+
+    _columns = std::move(graph.neighbors);
+    _columns.insert(_columns.end(), ghost_graph.neighbors.begin(), ghost_graph.neighbors.end());
+
+    _rowIndex.assign(static_cast<size_t>(mesh.GetNumNodes()), -1);
+    for (size_t ii = 0; ii < _rows.size(); ++ii) {
+        _rowIndex[static_cast<size_t>(_rows[ii])] = static_cast<Integer>(ii);
+    }
+
+    Log::Debug("Assembling {} of {} elements with {} colors on {} threads", _ownedElements.size(), element_ids.size(),
+               _colors.size(), _pool.NumThreads());
+}
+
+Integer ElementOwner(const SparsityPattern &pattern, const Element &element) {
+    // Elements go to the rank that owns most of their nodes (the lowest one on ties), so that most of the rows they add
+    // to are local:
+    std::array<Integer, max_nodes_per_element> node_owners = {};
+    Check(element.NumNodes() <= max_nodes_per_element, "Elements with {} nodes are not supported", element.NumNodes());
+
+    const auto num_nodes = static_cast<size_t>(element.NumNodes());
+    for (size_t ii = 0; ii < num_nodes; ++ii) {
+        node_owners[ii] = pattern.BlockRowOwner(element.GetNodeIndex(static_cast<Integer>(ii)));
+    }
+
+    std::sort(node_owners.begin(), node_owners.begin() + static_cast<std::ptrdiff_t>(num_nodes));
+
+    Integer owner = -1;
+    size_t owner_count = 0;
+    for (size_t ii = 0; ii < num_nodes;) {
+        auto jj = ii;
+        while (jj < num_nodes && node_owners[jj] == node_owners[ii]) {
+            ++jj;
+        }
+
+        if (jj - ii > owner_count) {
+            owner = node_owners[ii];
+            owner_count = jj - ii;
+        }
+        ii = jj;
+    }
+
+    return owner;
+}
+
+bool ElementAssembler::OwnsElement(const Element &element) const { return ElementOwner(_pattern, element) == _rank; }
+
+void ElementAssembler::AddElementMatrices(const ElementKernel &kernel, Matrix &matrix) {
+    if (_pool.NumThreads() == 1) {
+        auto &element_matrix = _elementMatrices.front();
+
+        std::vector<Integer> dofs;
+        for (const auto &element_id : _ownedElements) {
+            auto element = _mesh.GetElement(_dimension, element_id);
+
+            dofs.resize(static_cast<size_t>(_dofsPerNode * element->NumNodes()));
+            for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
+                for (Integer kk = 0; kk < _dofsPerNode; ++kk) {
+                    dofs[static_cast<size_t>(_dofsPerNode * ii + kk)] = _dofsPerNode * element->GetNodeIndex(ii) + kk;
+                }
+            }
+
+            kernel(*element, element_matrix);
+            matrix.AddElementMatrix(dofs, element_matrix);
+        }
+
+        return;
+    }
+
+    const auto block_entries = static_cast<size_t>(_dofsPerNode * _dofsPerNode);
+    _values.assign(_columns.size() * block_entries, 0.0);
+
+    // Elements of the same color touch disjoint rows, so the threads never write to the same values:
+    for (const auto &color : _colors) {
+        const auto num_elements = static_cast<Integer>(color.size());
+        const auto chunk_size = std::clamp(num_elements / (4 * _pool.NumThreads()), 1, max_elements_per_chunk);
+        _pool.ParallelFor(0, num_elements, chunk_size,
+                          [this, &color, &kernel](Integer begin, Integer end, Integer thread_index) {
+                              auto &element_matrix = _elementMatrices[static_cast<size_t>(thread_index)];
+                              for (auto ii = begin; ii < end; ++ii) {
+                                  auto element = _mesh.GetElement(_dimension, color[static_cast<size_t>(ii)]);
+                                  kernel(*element, element_matrix);
+                                  AddToRows(*element, element_matrix);
+                              }
+                          });
+    }
+
+    const std::span<const Integer> columns(_columns);
+    const std::span<const Float> values(_values);
+    for (size_t row = 0; row < _rows.size(); ++row) {
+        const auto begin = static_cast<size_t>(_rowOffsets[row]);
+        const auto size = static_cast<size_t>(_rowOffsets[row + 1]) - begin;
+
+        matrix.AddBlockRow(_rows[row], columns.subspan(begin, size),
+                           values.subspan(begin * block_entries, size * block_entries));
+    }
+}
+
+void ElementAssembler::AddToRows(const Element &element, const Eigen::MatrixXd &element_matrix) {
+    const auto num_nodes = element.NumNodes();
+    Check(element_matrix.rows() == _dofsPerNode * num_nodes && element_matrix.cols() == element_matrix.rows(),
+          "Element matrix of size {}x{} does not match the {} element dofs", element_matrix.rows(),
+          element_matrix.cols(), _dofsPerNode * num_nodes);
+
+    const auto block_size = static_cast<size_t>(_dofsPerNode);
+    for (Integer ii = 0; ii < num_nodes; ++ii) {
+        const auto row = static_cast<size_t>(_rowIndex[static_cast<size_t>(element.GetNodeIndex(ii))]);
+        const auto row_begin = _columns.begin() + _rowOffsets[row];
+        const auto row_end = _columns.begin() + _rowOffsets[row + 1];
+
+        for (Integer jj = 0; jj < num_nodes; ++jj) {
+            const auto position =
+                static_cast<size_t>(std::lower_bound(row_begin, row_end, element.GetNodeIndex(jj)) - _columns.begin());
+
+            // Blocks are column major within the block row (see Matrix::AddBlockRow):
+            auto *block = &_values[position * block_size * block_size];
+            for (size_t cc = 0; cc < block_size; ++cc) {
+                for (size_t rr = 0; rr < block_size; ++rr) {
+                    block[cc * block_size + rr] +=
+                        element_matrix(static_cast<Eigen::Index>(block_size * static_cast<size_t>(ii) + rr),
+                                       static_cast<Eigen::Index>(block_size * static_cast<size_t>(jj) + cc));
+                }
+            }
+        }
+    }
+}
+
+} // namespace plasmatic
@@ -1,48 +1,55 @@
 #include "interface/ProblemTypes/HeatEq2D.h"
+#include "interface/ProblemTypes/Assembly.h"
+#include "interface/ProblemTypes/ElementKernels.h"
+#include "interface/ProblemTypes/MatrixFree.h"
+#include "interface/ProblemTypes/Transient.h"
 
 #include "LinearAlgebra/LinearAlgebra.h"
 
+#include <Eigen/Dense>
+
 #include <iostream>
+#include <optional>
 
 namespace plasmatic {
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
-HeatEq2D::HeatEq2D(const Input &input) : _input(input), _mesh(input.mesh_filename) {}
+HeatEq2D::HeatEq2D(const Input &input)
+    : _input(input), _mesh(input.mesh_filename, input.num_threads, input.mesh_cache) {
+    _mesh.Reorder(input.node_ordering);
+}
 
 void HeatEq2D::Solve() {
     constexpr auto dimension = 2;
 
     _mesh.AddScalarField("temperature");
 
-    // Create global stiffness matrix and forcing vector
-    Matrix stiffness(_mesh.GetNumNodes(), _mesh.GetNumNodes());
-    Vector forcing(_mesh.GetNumNodes());
-    Vector temperature_vec_bcs(_mesh.GetNumNodes());
+    // Create global stiffness matrix and forcing vector. A matrix-free stiffness matrix applies the element matrices
+    // on the fly instead of assembling them:
+    std::optional<ElementAssembler> assembler;
+    std::optional<MatrixFreeOperator> matrix_free;
+    if (_input.matrix_free) {
+        const Eigen::MatrixXd conductivity =
+            _input.thermal_conductivity * Eigen::MatrixXd::Identity(dimension, dimension);
+        matrix_free.emplace(_mesh, dimension, 1, conductivity, _input.num_threads);
+    } else {
+        assembler.emplace(_mesh, dimension, 1, _input.num_threads);
+    }
 
-    // Loop over elements and add elemental stiffness matrix and forcing vector into the global ones
-    for (Integer element_id = 0; element_id < _mesh.GetNumElements(dimension); ++element_id) {
-        auto element = _mesh.GetElement(dimension, element_id);
-
-        for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
-            auto row = element->GetNodeIndex(ii);
-            for (Integer jj = 0; jj < element->NumNodes(); ++jj) {
-                auto col = element->GetNodeIndex(jj);
-
-                auto value = element->Integrate([element, ii, jj, this](const Coord &pos) -> Float {
-                    return _input.thermal_conductivity *
-                           (element->ShapeFnDerivative(ii, 0, pos) * element->ShapeFnDerivative(jj, 0, pos) +
-                            element->ShapeFnDerivative(ii, 1, pos) * element->ShapeFnDerivative(jj, 1, pos));
-                });
+    const auto &pattern = matrix_free ? matrix_free->Pattern() : assembler->Pattern();
+    const auto owns_element = [&](const Element &element) {
+        return matrix_free ? matrix_free->OwnsElement(element) : assembler->OwnsElement(element);
+    };
 
-                stiffness.AddValue(row, col, value);
-            }
-        }
-    }
-    stiffness.Assemble();
+    Vector forcing(pattern);
+    Vector temperature_vec_bcs(pattern);
 
     // Set boundary conditions
     constexpr auto bc_dimension = 1;
 
+    // The owned constrained rows are collected (nodes shared by several boundary elements more than once) and
+    // constrained in one pass over the matrix:
+    std::vector<Integer> dirichlet_rows;
     for (const auto &[physical_name, bc_value] : _input.dirichlet_bcs) {
         auto element_entities1 = _mesh.GetPhysicalEntity(physical_name, bc_dimension);
         for (const auto &element_entity : element_entities1) {
@@ -51,44 +58,118 @@ void HeatEq2D::Solve() {
                 auto element = _mesh.GetElement(bc_dimension, element_ind);
                 for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
                     auto node_ind = element->GetNodeIndex(ii);
-                    temperature_vec_bcs.SetValue(node_ind, bc_value);
-
-                    stiffness.SetDirichletBC(node_ind, temperature_vec_bcs, forcing);
+                    if (pattern.OwnsBlockRow(node_ind)) {
+                        temperature_vec_bcs.SetValue(node_ind, bc_value);
+                        dirichlet_rows.push_back(node_ind);
+                    }
                 }
             }
         }
     }
 
-    for (const auto &[physical_name, bc_value] : _input.neumann_bcs) {
-        auto element_entities2 = _mesh.GetPhysicalEntity(physical_name, bc_dimension);
-        for (const auto &element_entity : element_entities2) {
-            auto element_inds = _mesh.GetEntity(bc_dimension, element_entity);
-            for (const auto &element_ind : element_inds) {
-                auto element = _mesh.GetElement(bc_dimension, element_ind);
-                for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
-                    auto row = element->GetNodeIndex(ii);
-
-                    auto bc_value_copy = bc_value;
-                    auto value = element->Integrate([element, ii, bc_value_copy](const Coord &pos) -> Float {
-                        return bc_value_copy * element->ShapeFn(ii, pos);
-                    });
-
-                    forcing.AddValue(row, value);
+    temperature_vec_bcs.Assemble();
+
+    std::vector<Integer> dofs;
+    Eigen::VectorXd element_forcing;
+    const auto add_neumann_bcs = [&](Vector &vec) {
+        for (const auto &[physical_name, bc_value] : _input.neumann_bcs) {
+            auto element_entities2 = _mesh.GetPhysicalEntity(physical_name, bc_dimension);
+            for (const auto &element_entity : element_entities2) {
+                auto element_inds = _mesh.GetEntity(bc_dimension, element_entity);
+                for (const auto &element_ind : element_inds) {
+                    auto element = _mesh.GetElement(bc_dimension, element_ind);
+                    if (!owns_element(*element)) {
+                        continue;
+                    }
+
+                    dofs.resize(static_cast<size_t>(element->NumNodes()));
+                    element_forcing.setZero(element->NumNodes());
+
+                    for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
+                        dofs[static_cast<size_t>(ii)] = element->GetNodeIndex(ii);
+
+                        auto bc_value_copy = bc_value;
+                        element_forcing(ii) =
+                            element->Integrate([element, ii, bc_value_copy](const Coord &pos) -> Float {
+                                return bc_value_copy * element->ShapeFn(ii, pos);
+                            });
+                    }
+
+                    vec.AddElementVector(dofs, element_forcing);
                 }
             }
         }
+    };
+
+    if (_input.transient.method != TimeIntegration::Steady) {
+        Check(assembler.has_value(), "Transient heat conduction needs the assembled matrices, not matrix_free");
+
+        add_neumann_bcs(forcing);
+        forcing.Assemble();
+
+        const auto kernel = [this](Float stiffness_factor) -> ElementAssembler::ElementKernel {
+            return [this, stiffness_factor](const Element &element, Eigen::MatrixXd &element_matrix) {
+                VisitElement<dimension>(element, [&](const auto &typed_element) {
+                    element_matrix = MassMatrix(typed_element, _input.transient.heat_capacity) +
+                                     stiffness_factor * ConductionStiffness(typed_element, _input.thermal_conductivity);
+                });
+            };
+        };
+
+        Vector initial_temperature(pattern);
+        initial_temperature.View().Map().setConstant(_input.transient.initial_temperature);
+
+        // Every kept step is written right away, so only the last one stays in the mesh:
+        const auto output = [this](const TemperatureSnapshot &snapshot) {
+            SetTemperature(snapshot.temperature);
+            if (!_input.transient.output_filename.empty() && CommRank() == 0) {
+                _mesh.WriteVTK(StepFilename(_input.transient.output_filename, snapshot.step));
+            }
+        };
+
+        SolveTransientHeat(*assembler, kernel, dirichlet_rows, temperature_vec_bcs, forcing, initial_temperature,
+                           _input.transient, _input.solver, output);
+        return;
     }
+
+    // Loop over elements and add elemental stiffness matrix and forcing vector into the global ones
+    Matrix stiffness = matrix_free ? matrix_free->CreateMatrix() : Matrix(pattern);
+    if (assembler) {
+        assembler->AddElementMatrices(
+            [this](const Element &element, Eigen::MatrixXd &element_matrix) {
+                VisitElement<dimension>(element, [&element_matrix, this](const auto &typed_element) {
+                    element_matrix = ConductionStiffness(typed_element, _input.thermal_conductivity);
+                });
+            },
+            stiffness);
+        stiffness.Assemble();
+    }
+
+    stiffness.SetDirichletBCs(dirichlet_rows, temperature_vec_bcs, forcing);
+    add_neumann_bcs(forcing);
     stiffness.Assemble();
     forcing.Assemble();
 
     // Solve stiffness matrix/forcing vector equation for temperature
     Log::Info("Beginning linear solve");
-    auto temperature_vec = stiffness.Solve(forcing);
+    auto temperature_vec = stiffness.Solve(forcing, _input.solver);
     Log::Info("Finished linear solve");
 
-    // Transfer solution to mesh field
-    for (Integer ii = 0; ii < temperature_vec.Size(); ++ii) {
-        _mesh.ScalarFieldSetValue("temperature", ii, temperature_vec.GetValue(ii));
+    // Every rank gets the whole solution:
+    SetTemperature(temperature_vec.GatherAll());
+}
+
+void HeatEq2D::WriteVTK(const std::filesystem::path &output_filename) {
+    if (CommRank() != 0) {
+        return;
+    }
+
+    _mesh.WriteVTK(output_filename);
+}
+
+void HeatEq2D::SetTemperature(const std::vector<Float> &temperature) {
+    for (Integer ii = 0; ii < _mesh.GetNumNodes(); ++ii) {
+        _mesh.ScalarFieldSetValue("temperature", ii, temperature[static_cast<size_t>(ii)]);
     }
 }
 
@@ -0,0 +1,421 @@
+#include "interface/ProblemTypes/MatrixFree.h"
+#include "interface/ProblemTypes/Assembly.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace plasmatic {
+
+namespace {
+
+// Calls visitor with std::type_identity of the element type with the given VTK cell type:
+template <typename Visitor> void VisitElementType(Integer vtk_cell_type, Visitor &&visitor) {
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    switch (vtk_cell_type) {
+    case 5:
+        visitor(std::type_identity<Triangle>{});
+        break;
+    case 22:
+        visitor(std::type_identity<TriangleOrder2>{});
+        break;
+    case 10:
+        visitor(std::type_identity<Tetrahedron>{});
+        break;
+    case 24:
+        visitor(std::type_identity<TetrahedronOrder2>{});
+        break;
+    default:
+        Abort("Matrix-free products don't support elements with VTK cell type {}", vtk_cell_type);
+    }
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+}
+
+// Parent coordinate derivatives of the shape functions at every quadrature point (one row per dimension, one column per
+// node), shared by all elements of the type:
+template <typename ElementType> const auto &ReferenceDerivatives() {
+    using Quadrature = typename ElementType::Quadrature;
+    using Derivatives = Eigen::Matrix<Float, Quadrature::dimension, Quadrature::num_nodes>;
+
+    static const auto derivatives = [] {
+        const auto &table = ElementType::GetReferenceTable();
+
+        std::array<Derivatives, Quadrature::num_points> result;
+        for (size_t ii = 0; ii < result.size(); ++ii) {
+            for (Integer jj = 0; jj < Quadrature::num_nodes; ++jj) {
+                for (Integer kk = 0; kk < Quadrature::dimension; ++kk) {
+                    result[ii](kk, jj) =
+                        table.shape_fn_derivatives[ii][static_cast<size_t>(jj)][static_cast<size_t>(kk)];
+                }
+            }
+        }
+
+        return result;
+    }();
+
+    return derivatives;
+}
+
+template <typename ElementType> constexpr size_t FactorsPerElement() {
+    using Quadrature = typename ElementType::Quadrature;
+    return static_cast<size_t>(Quadrature::num_points * (1 + Quadrature::dimension * Quadrature::dimension));
+}
+
+// Weight and inverse Jacobian of every quadrature point of an element, like EvaluateReferenceTable computes them:
+template <typename ElementType>
+void ComputeFactors(const Mesh &mesh, std::span<const Integer> element_nodes, std::span<Float> factors) {
+    using Quadrature = typename ElementType::Quadrature;
+    constexpr auto dimension = Quadrature::dimension;
+    constexpr auto num_nodes = Quadrature::num_nodes;
+
+    Eigen::Matrix<Float, num_nodes, dimension> node_coords;
+    for (Integer ii = 0; ii < num_nodes; ++ii) {
+        const auto position = mesh.GetNodePosition(element_nodes[static_cast<size_t>(ii)]);
+        const std::array<Float, 3> coords = {position.x, position.y, position.z};
+        for (Integer jj = 0; jj < dimension; ++jj) {
+            node_coords(ii, jj) = coords[static_cast<size_t>(jj)];
+        }
+    }
+
+    const auto &table = ElementType::GetReferenceTable();
+    const auto &derivatives = ReferenceDerivatives<ElementType>();
+    constexpr auto stride = static_cast<size_t>(1 + dimension * dimension);
+    for (size_t ii = 0; ii < derivatives.size(); ++ii) {
+        const Eigen::Matrix<Float, dimension, dimension> jacobian = derivatives[ii] * node_coords;
+
+        // Like EvaluateReferenceTable the weight doesn't depend on the orientation of the element, but a flat element
+        // has no inverse Jacobian:
+        const auto determinant = jacobian.determinant();
+        Check(std::abs(determinant) > 0.0, "Degenerate element with first node {}", element_nodes[0]);
+
+        factors[ii * stride] = table.weights[ii] * std::abs(determinant);
+        Eigen::Map<Eigen::Matrix<Float, dimension, dimension>> inverse_jacobian(&factors[ii * stride + 1]);
+        inverse_jacobian = jacobian.inverse();
+    }
+}
+
+// Weight and inverse Jacobian at quadrature point ii from the factors of an element:
+template <Integer Dim> auto Factors(std::span<const Float> factors, size_t ii) {
+    constexpr auto stride = static_cast<size_t>(1 + Dim * Dim);
+    return std::pair{factors[ii * stride], Eigen::Map<const Eigen::Matrix<Float, Dim, Dim>>(&factors[ii * stride + 1])};
+}
+
+// Engineering strain (Voigt notation like StrainDisplacementMatrix) of a displacement gradient with one row per
+// derivative and one column per displacement component:
+Eigen::Matrix<Float, 6, 1> VoigtStrain(const Eigen::Matrix<Float, 3, 3> &gradient) {
+    Eigen::Matrix<Float, 6, 1> strain;
+    strain << gradient(0, 0), gradient(1, 1), gradient(2, 2), gradient(1, 0) + gradient(0, 1),
+        gradient(2, 1) + gradient(1, 2), gradient(2, 0) + gradient(0, 2);
+
+    return strain;
+}
+
+// The transpose of VoigtStrain, so that the element vector is the transposed derivatives times this:
+Eigen::Matrix<Float, 3, 3> StressMatrix(const Eigen::Matrix<Float, 6, 1> &stress) {
+    Eigen::Matrix<Float, 3, 3> result;
+    result << stress(0), stress(3), stress(5), stress(3), stress(1), stress(4), stress(5), stress(4), stress(2);
+
+    return result;
+}
+
+// y_e += K_e x_e for one element, with one row per node and one column per unknown of the node:
+template <typename ElementType, Integer DofsPerNode>
+void ApplyElement(std::span<const Float> factors, const Eigen::MatrixXd &material,
+                  const Eigen::Matrix<Float, ElementType::Quadrature::num_nodes, DofsPerNode> &x,
+                  Eigen::Matrix<Float, ElementType::Quadrature::num_nodes, DofsPerNode> &y) {
+    constexpr auto dimension = ElementType::Quadrature::dimension;
+    const auto &derivatives = ReferenceDerivatives<ElementType>();
+
+    for (size_t ii = 0; ii < derivatives.size(); ++ii) {
+        const auto [weight, inverse_jacobian] = Factors<dimension>(factors, ii);
+        const Eigen::Matrix<Float, dimension, DofsPerNode> gradient = inverse_jacobian * (derivatives[ii] * x);
+
+        if constexpr (DofsPerNode == 1) {
+            const Eigen::Matrix<Float, dimension, 1> flux =
+                weight * material.topLeftCorner<dimension, dimension>() * gradient;
+            y.noalias() += derivatives[ii].transpose() * (inverse_jacobian.transpose() * flux);
+        } else {
+            const Eigen::Matrix<Float, 6, 1> stress = weight * material.topLeftCorner<6, 6>() * VoigtStrain(gradient);
+            y.noalias() += derivatives[ii].transpose() * (inverse_jacobian.transpose() * StressMatrix(stress));
+        }
+    }
+}
+
+// The diagonal of K_e, laid out like y in ApplyElement:
+template <typename ElementType, Integer DofsPerNode>
+void AddElementDiagonal(std::span<const Float> factors, const Eigen::MatrixXd &material,
+                        Eigen::Matrix<Float, ElementType::Quadrature::num_nodes, DofsPerNode> &diagonal) {
+    constexpr auto dimension = ElementType::Quadrature::dimension;
+    const auto &derivatives = ReferenceDerivatives<ElementType>();
+
+    for (size_t ii = 0; ii < derivatives.size(); ++ii) {
+        const auto [weight, inverse_jacobian] = Factors<dimension>(factors, ii);
+        const Eigen::Matrix<Float, dimension, ElementType::Quadrature::num_nodes> gradients =
+            inverse_jacobian * derivatives[ii];
+
+        for (Integer jj = 0; jj < ElementType::Quadrature::num_nodes; ++jj) {
+            const auto gradient = gradients.col(jj);
+
+            if constexpr (DofsPerNode == 1) {
+                diagonal(jj, 0) +=
+                    weight * gradient.dot(material.topLeftCorner<dimension, dimension>() * gradient);
+            } else {
+                // The columns of the strain--displacement matrix of the node:
+                for (Integer kk = 0; kk < DofsPerNode; ++kk) {
+                    Eigen::Matrix<Float, 3, 3> unit_gradient = Eigen::Matrix<Float, 3, 3>::Zero();
+                    unit_gradient.col(kk) = gradient;
+
+                    const auto strain = VoigtStrain(unit_gradient);
+                    diagonal(jj, kk) += weight * strain.dot(material.topLeftCorner<6, 6>() * strain);
+                }
+            }
+        }
+    }
+}
+
+// Upper bound on the number of elements a thread grabs at once:
+constexpr Integer max_elements_per_chunk = 64;
+
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+MatrixFreeOperator::MatrixFreeOperator(const Mesh &mesh, Integer dimension, Integer dofs_per_node,
+                                       const Eigen::MatrixXd &material, Integer num_threads)
+    : _mesh(mesh), _dimension(dimension), _dofsPerNode(dofs_per_node), _rank(CommRank()), _material(material),
+      _pattern(dofs_per_node * mesh.GetNumNodes(), dofs_per_node),
+      _pool(num_threads > 0 ? num_threads : ThreadPool::HardwareThreads()) {
+    if (dofs_per_node == 1) {
+        Check(material.rows() == dimension && material.cols() == dimension,
+              "Conductivity of size {}x{} doesn't match dimension {}", material.rows(), material.cols(), dimension);
+    } else {
+        Check(dofs_per_node == 3 && dimension == 3, "Matrix-free products with {} unknowns per node in dimension {}",
+              dofs_per_node, dimension);
+        Check(material.rows() == 6 && material.cols() == 6, "Elasticity matrix of size {}x{} isn't 6x6",
+              material.rows(), material.cols());
+    }
+
+    // The owned rows come first in the local numbering of the nodes:
+    const auto node_start = _pattern.BlockRowStart();
+    _localNodes.assign(static_cast<size_t>(mesh.GetNumNodes()), -1);
+    for (auto node = node_start; node < _pattern.BlockRowEnd(); ++node) {
+        _localNodes[static_cast<size_t>(node)] = node - node_start;
+    }
+
+    // Owned elements and the (owned block, position) of every element, which the colors are sorted into:
+    const auto &blocks = mesh.GetElementBlocks(dimension);
+    std::vector<std::pair<Integer, Integer>> owned_positions(static_cast<size_t>(mesh.GetNumElements(dimension)),
+                                                             {-1, -1});
+    std::vector<Integer> ghost_nodes;
+    for (size_t ii = 0; ii < blocks.size(); ++ii) {
+        const auto &block = blocks[ii];
+
+        OwnedBlock owned = {.block = ii, .elements = {}, .factors = {}, .colors = {}};
+        for (Integer jj = 0; jj < block.NumElements(); ++jj) {
+            const auto element_id = block.first_element + jj;
+            if (!OwnsElement(*mesh.GetElement(dimension, element_id))) {
+                continue;
+            }
+
+            owned_positions[static_cast<size_t>(element_id)] = {static_cast<Integer>(_blocks.size()),
+                                                                static_cast<Integer>(owned.elements.size())};
+            owned.elements.push_back(jj);
+
+            for (const auto &node : block.ElementNodes(jj)) {
+                if (_localNodes[static_cast<size_t>(node)] < 0) {
+                    _localNodes[static_cast<size_t>(node)] = 0; // numbered below
+                    ghost_nodes.push_back(node);
+                }
+            }
+        }
+
+        if (!owned.elements.empty()) {
+            _blocks.push_back(std::move(owned));
+        }
+    }
+
+    // The ghost rows follow in increasing order:
+    std::sort(ghost_nodes.begin(), ghost_nodes.end());
+    auto num_local_nodes = _pattern.BlockRowEnd() - node_start;
+    for (const auto &node : ghost_nodes) {
+        _localNodes[static_cast<size_t>(node)] = num_local_nodes++;
+        for (Integer ii = 0; ii < dofs_per_node; ++ii) {
+            _ghostRows.push_back(dofs_per_node * node + ii);
+        }
+    }
+
+    for (auto &owned : _blocks) {
+        const auto &block = blocks[owned.block];
+        VisitElementType(block.vtk_cell_type, [&](auto element_type) {
+            using ElementType = typename decltype(element_type)::type;
+            constexpr auto stride = FactorsPerElement<ElementType>();
+
+            owned.factors.resize(owned.elements.size() * stride);
+            const auto num_elements = static_cast<Integer>(owned.elements.size());
+            _pool.ParallelFor(0, num_elements, max_elements_per_chunk, [&](Integer begin, Integer end, Integer) {
+                for (auto ii = static_cast<size_t>(begin); ii < static_cast<size_t>(end); ++ii) {
+                    ComputeFactors<ElementType>(mesh, block.ElementNodes(owned.elements[ii]),
+                                                std::span<Float>(owned.factors).subspan(ii * stride, stride));
+                }
+            });
+        });
+    }
+
+    if (_pool.NumThreads() > 1) {
+        const auto colors = mesh.ColorElements(dimension);
+        for (auto &owned : _blocks) {
+            owned.colors.resize(colors.size());
+        }
+
+        for (size_t ii = 0; ii < colors.size(); ++ii) {
+            for (const auto &element_id : colors[ii]) {
+                const auto [owned_block, position] = owned_positions[static_cast<size_t>(element_id)];
+                if (owned_block >= 0) {
+                    _blocks[static_cast<size_t>(owned_block)].colors[ii].push_back(position);
+                }
+            }
+        }
+
+        for (auto &owned : _blocks) {
+            std::erase_if(owned.colors, [](const std::vector<Integer> &color) { return color.empty(); });
+        }
+    }
+
+    size_t num_owned = 0;
+    for (const auto &owned : _blocks) {
+        num_owned += owned.elements.size();
+    }
+
+    constexpr Float bytes_per_megabyte = 1024.0 * 1024.0;
+    Log::Info("Matrix-free operator over {} of {} elements ({:.1f} MB)", num_owned, owned_positions.size(),
+              static_cast<Float>(MemoryBytes()) / bytes_per_megabyte);
+}
+
+bool MatrixFreeOperator::OwnsElement(const Element &element) const {
+    return ElementOwner(_pattern, element) == _rank;
+}
+
+Matrix MatrixFreeOperator::CreateMatrix() {
+    return Matrix(
+        _pattern, _ghostRows, [this](std::span<const Float> x, std::span<Float> y) { Apply(x, y); },
+        [this](std::span<Float> diagonal) { Diagonal(diagonal); });
+}
+
+template <typename Function> void MatrixFreeOperator::ForEachElement(const OwnedBlock &owned, Function &&fn) {
+    if (_pool.NumThreads() == 1) {
+        for (Integer ii = 0; ii < static_cast<Integer>(owned.elements.size()); ++ii) {
+            fn(ii);
+        }
+        return;
+    }
+
+    // Elements of the same color share no nodes, so the threads never add to the same rows:
+    for (const auto &color : owned.colors) {
+        const auto num_elements = static_cast<Integer>(color.size());
+        const auto chunk_size = std::clamp(num_elements / (4 * _pool.NumThreads()), 1, max_elements_per_chunk);
+        _pool.ParallelFor(0, num_elements, chunk_size, [&](Integer begin, Integer end, Integer /*thread_index*/) {
+            for (auto ii = begin; ii < end; ++ii) {
+                fn(color[static_cast<size_t>(ii)]);
+            }
+        });
+    }
+}
+
+void MatrixFreeOperator::Apply(std::span<const Float> x, std::span<Float> y) {
+    const auto &blocks = _mesh.GetElementBlocks(_dimension);
+    const auto dofs_per_node = static_cast<size_t>(_dofsPerNode);
+
+    for (const auto &owned : _blocks) {
+        const auto &block = blocks[owned.block];
+        VisitElementType(block.vtk_cell_type, [&](auto element_type) {
+            using ElementType = typename decltype(element_type)::type;
+            constexpr auto num_nodes = ElementType::Quadrature::num_nodes;
+            constexpr auto stride = FactorsPerElement<ElementType>();
+
+            const auto apply = [&]<Integer DofsPerNode>(std::integral_constant<Integer, DofsPerNode>) {
+                ForEachElement(owned, [&](Integer position) {
+                    const auto element_nodes = block.ElementNodes(owned.elements[static_cast<size_t>(position)]);
+
+                    Eigen::Matrix<Float, num_nodes, DofsPerNode> element_x;
+                    for (Integer ii = 0; ii < num_nodes; ++ii) {
+                        const auto node = static_cast<size_t>(_localNodes[static_cast<size_t>(element_nodes[ii])]);
+                        for (Integer jj = 0; jj < DofsPerNode; ++jj) {
+                            element_x(ii, jj) = x[node * dofs_per_node + static_cast<size_t>(jj)];
+                        }
+                    }
+
+                    Eigen::Matrix<Float, num_nodes, DofsPerNode> element_y =
+                        Eigen::Matrix<Float, num_nodes, DofsPerNode>::Zero();
+                    ApplyElement<ElementType, DofsPerNode>(
+                        std::span<const Float>(owned.factors).subspan(static_cast<size_t>(position) * stride, stride),
+                        _material, element_x, element_y);
+
+                    for (Integer ii = 0; ii < num_nodes; ++ii) {
+                        const auto node = static_cast<size_t>(_localNodes[static_cast<size_t>(element_nodes[ii])]);
+                        for (Integer jj = 0; jj < DofsPerNode; ++jj) {
+                            y[node * dofs_per_node + static_cast<size_t>(jj)] += element_y(ii, jj);
+                        }
+                    }
+                });
+            };
+
+            if constexpr (ElementType::Quadrature::dimension == 3) {
+                if (_dofsPerNode == 3) {
+                    apply(std::integral_constant<Integer, 3>{});
+                    return;
+                }
+            }
+            apply(std::integral_constant<Integer, 1>{});
+        });
+    }
+}
+
+void MatrixFreeOperator::Diagonal(std::span<Float> diagonal) {
+    const auto &blocks = _mesh.GetElementBlocks(_dimension);
+    const auto dofs_per_node = static_cast<size_t>(_dofsPerNode);
+
+    for (const auto &owned : _blocks) {
+        const auto &block = blocks[owned.block];
+        VisitElementType(block.vtk_cell_type, [&](auto element_type) {
+            using ElementType = typename decltype(element_type)::type;
+            constexpr auto num_nodes = ElementType::Quadrature::num_nodes;
+            constexpr auto stride = FactorsPerElement<ElementType>();
+
+            const auto add_diagonal = [&]<Integer DofsPerNode>(std::integral_constant<Integer, DofsPerNode>) {
+                ForEachElement(owned, [&](Integer position) {
+                    const auto element_nodes = block.ElementNodes(owned.elements[static_cast<size_t>(position)]);
+
+                    Eigen::Matrix<Float, num_nodes, DofsPerNode> element_diagonal =
+                        Eigen::Matrix<Float, num_nodes, DofsPerNode>::Zero();
+                    AddElementDiagonal<ElementType, DofsPerNode>(
+                        std::span<const Float>(owned.factors).subspan(static_cast<size_t>(position) * stride, stride),
+                        _material, element_diagonal);
+
+                    for (Integer ii = 0; ii < num_nodes; ++ii) {
+                        const auto node = static_cast<size_t>(_localNodes[static_cast<size_t>(element_nodes[ii])]);
+                        for (Integer jj = 0; jj < DofsPerNode; ++jj) {
+                            diagonal[node * dofs_per_node + static_cast<size_t>(jj)] += element_diagonal(ii, jj);
+                        }
+                    }
+                });
+            };
+
+            if constexpr (ElementType::Quadrature::dimension == 3) {
+                if (_dofsPerNode == 3) {
+                    add_diagonal(std::integral_constant<Integer, 3>{});
+                    return;
+                }
+            }
+            add_diagonal(std::integral_constant<Integer, 1>{});
+        });
+    }
+}
+
+size_t MatrixFreeOperator::MemoryBytes() const {
+    size_t bytes = (_localNodes.size() + _ghostRows.size()) * sizeof(Integer);
+    for (const auto &owned : _blocks) {
+        bytes += owned.elements.size() * sizeof(Integer) + owned.factors.size() * sizeof(Float);
+    }
+
+    return bytes;
+}
+
+} // namespace plasmatic
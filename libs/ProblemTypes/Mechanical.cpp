@@ -1,31 +1,24 @@
 #include "interface/ProblemTypes/Mechanical.h"
+#include "interface/ProblemTypes/Assembly.h"
+#include "interface/ProblemTypes/ElementKernels.h"
+#include "interface/ProblemTypes/MatrixFree.h"
 
 #include "LinearAlgebra/LinearAlgebra.h"
 
 #include <Eigen/Dense>
 
 #include <iostream>
+#include <optional>
 
 namespace plasmatic {
 
-// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
-Mechanical::Mechanical(const Input &input) : _input(input), _mesh(input.mesh_filename) {}
-
-void Mechanical::Solve() {
-    constexpr auto dimension = 3;
-
-    _mesh.AddVectorField("displacement");
+namespace {
 
-    // Create global stiffness matrix and forcing vector
-    Matrix stiffness(3 * _mesh.GetNumNodes(), 3 * _mesh.GetNumNodes());
-    Vector forcing(3 * _mesh.GetNumNodes());
-    Vector displacement_vec_bcs(3 * _mesh.GetNumNodes());
-
-    auto E = _input.youngs_modulus;
-    auto v = _input.poisson_ratio;
+// The isotropic stress-strain matrix in Voigt notation:
+Eigen::Matrix<Float, 6, 6> ElasticityMatrix(Float E, Float v) {
     auto constant = E / ((1.0 + v) * (1.0 - 2.0 * v));
 
-    Eigen::MatrixXd D = Eigen::MatrixXd::Zero(6, 6);
+    Eigen::Matrix<Float, 6, 6> D = Eigen::Matrix<Float, 6, 6>::Zero();
     D(0, 0) = constant * (1.0 - v);
     D(1, 1) = constant * (1.0 - v);
     D(2, 2) = constant * (1.0 - v);
@@ -39,59 +32,48 @@ void Mechanical::Solve() {
     D(2, 0) = constant * v;
     D(2, 1) = constant * v;
 
-    // Loop over elements and add elemental stiffness matrix and forcing vector into the global ones
-    for (Integer element_id = 0; element_id < _mesh.GetNumElements(dimension); ++element_id) {
-        auto element = _mesh.GetElement(dimension, element_id);
+    return D;
+}
 
-        for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
-            auto row = element->GetNodeIndex(ii);
-            for (Integer jj = 0; jj < element->NumNodes(); ++jj) {
-                auto col = element->GetNodeIndex(jj);
-
-                auto value = element->Integrate(
-                    [element, ii, jj, D](const Coord &pos) -> Eigen::MatrixXd {
-                        // Create the strain--displacement matrices:
-                        Eigen::MatrixXd Ba = Eigen::MatrixXd::Zero(6, 3);
-                        Ba(0, 0) = element->ShapeFnDerivative(ii, 0, pos);
-                        Ba(1, 1) = element->ShapeFnDerivative(ii, 1, pos);
-                        Ba(2, 2) = element->ShapeFnDerivative(ii, 2, pos);
-                        Ba(3, 0) = element->ShapeFnDerivative(ii, 1, pos);
-                        Ba(3, 1) = element->ShapeFnDerivative(ii, 0, pos);
-                        Ba(4, 1) = element->ShapeFnDerivative(ii, 2, pos);
-                        Ba(4, 2) = element->ShapeFnDerivative(ii, 1, pos);
-                        Ba(5, 0) = element->ShapeFnDerivative(ii, 2, pos);
-                        Ba(5, 2) = element->ShapeFnDerivative(ii, 0, pos);
-
-                        Eigen::MatrixXd Bb = Eigen::MatrixXd::Zero(6, 3);
-                        Bb(0, 0) = element->ShapeFnDerivative(jj, 0, pos);
-                        Bb(1, 1) = element->ShapeFnDerivative(jj, 1, pos);
-                        Bb(2, 2) = element->ShapeFnDerivative(jj, 2, pos);
-                        Bb(3, 0) = element->ShapeFnDerivative(jj, 1, pos);
-                        Bb(3, 1) = element->ShapeFnDerivative(jj, 0, pos);
-                        Bb(4, 1) = element->ShapeFnDerivative(jj, 2, pos);
-                        Bb(4, 2) = element->ShapeFnDerivative(jj, 1, pos);
-                        Bb(5, 0) = element->ShapeFnDerivative(jj, 2, pos);
-                        Bb(5, 2) = element->ShapeFnDerivative(jj, 0, pos);
-
-                        Eigen::MatrixXd inner_mat = Ba.transpose() * D * Bb;
-
-                        return inner_mat;
-                    },
-                    3, 3);
-
-                for (Integer kk = 0; kk < 3; ++kk) {
-                    for (Integer mm = 0; mm < 3; ++mm) {
-                        stiffness.AddValue(3 * row + kk, 3 * col + mm, value(kk, mm));
-                    }
-                }
-            }
-        }
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+Mechanical::Mechanical(const Input &input)
+    : _input(input), _mesh(input.mesh_filename, input.num_threads, input.mesh_cache) {
+    _mesh.Reorder(input.node_ordering);
+}
+
+void Mechanical::Solve() {
+    constexpr auto dimension = 3;
+
+    const auto D = ElasticityMatrix(_input.youngs_modulus, _input.poisson_ratio);
+
+    // Create global stiffness matrix and forcing vector. A matrix-free stiffness matrix applies the element matrices
+    // on the fly instead of assembling them:
+    std::optional<ElementAssembler> assembler;
+    std::optional<MatrixFreeOperator> matrix_free;
+    if (_input.matrix_free) {
+        matrix_free.emplace(_mesh, dimension, 3, D, _input.num_threads);
+    } else {
+        assembler.emplace(_mesh, dimension, 3, _input.num_threads);
     }
-    stiffness.Assemble();
+
+    const auto &pattern = matrix_free ? matrix_free->Pattern() : assembler->Pattern();
+    const auto owns_element = [&](const Element &element) {
+        return matrix_free ? matrix_free->OwnsElement(element) : assembler->OwnsElement(element);
+    };
+
+    Matrix stiffness = matrix_free ? matrix_free->CreateMatrix() : Matrix(pattern, _input.matrix_format);
+    Vector forcing(pattern);
 
     // Set boundary conditions
     constexpr auto bc_dimension = 2;
 
+    // The prescribed displacements of all nodes, not only the owned ones, since the owned elements also reach into the
+    // nodes of other ranks:
+    const auto num_dofs = 3 * static_cast<size_t>(_mesh.GetNumNodes());
+    std::vector<bool> constrained(num_dofs, false);
+    std::vector<Float> prescribed(num_dofs, 0.0);
     for (const auto &[physical_name, bc_value] : _input.dirichlet_bcs) {
         auto element_entities1 = _mesh.GetPhysicalEntity(physical_name, bc_dimension);
         for (const auto &element_entity : element_entities1) {
@@ -99,66 +81,219 @@ void Mechanical::Solve() {
             for (const auto &element_ind : element_inds) {
                 auto element = _mesh.GetElement(bc_dimension, element_ind);
                 for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
-                    auto node_ind = element->GetNodeIndex(ii);
-                    for (Integer jj = 0; jj < 3; ++jj) {
-                        displacement_vec_bcs.SetValue(3 * node_ind + jj, bc_value[static_cast<size_t>(jj)]);
-
-                        stiffness.SetDirichletBC(3 * node_ind + jj, displacement_vec_bcs, forcing);
+                    auto node_ind = static_cast<size_t>(element->GetNodeIndex(ii));
+                    for (size_t jj = 0; jj < 3; ++jj) {
+                        constrained[3 * node_ind + jj] = true;
+                        prescribed[3 * node_ind + jj] = bc_value[jj];
                     }
                 }
             }
         }
     }
 
-    for (const auto &[physical_name, bc_value] : _input.neumann_bcs) {
-        auto element_entities2 = _mesh.GetPhysicalEntity(physical_name, bc_dimension);
-        for (const auto &element_entity : element_entities2) {
-            auto element_inds = _mesh.GetEntity(bc_dimension, element_entity);
-            for (const auto &element_ind : element_inds) {
-                auto element = _mesh.GetElement(bc_dimension, element_ind);
-                for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
-                    auto row = element->GetNodeIndex(ii);
+    // PETSc can't zero the rows and columns of symmetric block matrices, which only store the upper triangle. Instead
+    // the constrained rows and columns are left out of the element matrices, and the prescribed displacements are moved
+    // to the forcing:
+    const bool eliminate_dirichlet_bcs = assembler && _input.matrix_format == MatrixFormat::SymmetricBlockAIJ;
+    if (eliminate_dirichlet_bcs) {
+        const auto preconditioner = _input.solver.preconditioner;
+        Check(preconditioner != Preconditioner::GAMG && preconditioner != Preconditioner::ILU &&
+                  preconditioner != Preconditioner::LU,
+              "The symmetric block matrix format (sbaij) only supports Jacobi and Cholesky preconditioning");
+    }
+
+    const auto element_dof = [](const Element &element, Integer ii) {
+        return 3 * element.GetNodeIndex(ii / 3) + ii % 3;
+    };
+    const auto element_stiffness = [&D](const Element &element, Eigen::MatrixXd &element_matrix) {
+        VisitElement<dimension>(element, [&element_matrix, &D](const auto &typed_element) {
+            element_matrix = ElasticStiffness(typed_element, D);
+        });
+    };
 
-                    auto bc_value_copy = bc_value;
-                    for (Integer jj = 0; jj < 3; ++jj) {
-                        auto value = element->Integrate([element, ii, bc_value_copy, jj](const Coord &pos) -> Float {
-                            return bc_value_copy[static_cast<size_t>(jj)] * element->ShapeFn(ii, pos);
-                        });
+    // Loop over elements and add elemental stiffness matrix and forcing vector into the global ones
+    if (assembler) {
+        assembler->AddElementMatrices(
+            [&](const Element &element, Eigen::MatrixXd &element_matrix) {
+                element_stiffness(element, element_matrix);
+                if (!eliminate_dirichlet_bcs) {
+                    return;
+                }
 
-                        forcing.AddValue(3 * row + jj, value);
+                for (Integer ii = 0; ii < 3 * element.NumNodes(); ++ii) {
+                    if (constrained[static_cast<size_t>(element_dof(element, ii))]) {
+                        element_matrix.row(ii).setZero();
+                        element_matrix.col(ii).setZero();
                     }
                 }
+            },
+            stiffness);
+        stiffness.Assemble();
+
+        // Algebraic multigrid only coarsens elasticity well if it knows the rigid body modes, and the modes are kept
+        // with the matrix in case the preconditioner is chosen on the command line:
+        Vector coordinates(pattern);
+        {
+            const auto values = coordinates.View();
+            for (auto node = pattern.BlockRowStart(); node < pattern.BlockRowEnd(); ++node) {
+                const auto position = _mesh.GetNodePosition(node);
+                const auto row = 3 * (node - pattern.BlockRowStart());
+                values[row] = position.x;
+                values[row + 1] = position.y;
+                values[row + 2] = position.z;
+            }
+        }
+
+        stiffness.SetRigidBodyModes(coordinates);
+    }
+
+    if (eliminate_dirichlet_bcs) {
+        // The forcing of the free rows loses the columns of the prescribed displacements:
+        std::vector<Integer> element_dofs;
+        Eigen::MatrixXd element_matrix;
+        Eigen::VectorXd element_prescribed;
+        for (Integer element_id = 0; element_id < _mesh.GetNumElements(dimension); ++element_id) {
+            auto element = _mesh.GetElement(dimension, element_id);
+            if (!owns_element(*element)) {
+                continue;
+            }
+
+            const auto num_element_dofs = 3 * element->NumNodes();
+            element_dofs.resize(static_cast<size_t>(num_element_dofs));
+            element_prescribed.setZero(num_element_dofs);
+            bool has_constrained_dofs = false;
+            for (Integer ii = 0; ii < num_element_dofs; ++ii) {
+                const auto dof = element_dof(*element, ii);
+                element_dofs[static_cast<size_t>(ii)] = dof;
+                if (constrained[static_cast<size_t>(dof)]) {
+                    element_prescribed(ii) = prescribed[static_cast<size_t>(dof)];
+                    has_constrained_dofs = true;
+                }
+            }
+
+            if (!has_constrained_dofs) {
+                continue;
             }
+
+            element_stiffness(*element, element_matrix);
+            forcing.AddElementVector(element_dofs, -element_matrix * element_prescribed);
         }
+        forcing.Assemble();
+
+        // The constrained rows are left with the identity and their prescribed displacement:
+        for (auto dof = 3 * pattern.BlockRowStart(); dof < 3 * pattern.BlockRowEnd(); ++dof) {
+            if (constrained[static_cast<size_t>(dof)]) {
+                stiffness.SetValue(dof, dof, 1.0);
+                forcing.SetValue(dof, prescribed[static_cast<size_t>(dof)]);
+            }
+        }
+        forcing.Assemble();
+    } else {
+        // The owned constrained rows are constrained in one pass over the matrix:
+        std::vector<Integer> dirichlet_rows;
+        Vector displacement_vec_bcs(pattern);
+        for (auto dof = 3 * pattern.BlockRowStart(); dof < 3 * pattern.BlockRowEnd(); ++dof) {
+            if (constrained[static_cast<size_t>(dof)]) {
+                displacement_vec_bcs.SetValue(dof, prescribed[static_cast<size_t>(dof)]);
+                dirichlet_rows.push_back(dof);
+            }
+        }
+
+        displacement_vec_bcs.Assemble();
+        stiffness.SetDirichletBCs(dirichlet_rows, displacement_vec_bcs, forcing);
     }
+
+    std::vector<Integer> dofs;
+    Eigen::VectorXd element_forcing;
+    const auto add_neumann_bcs = [&](const std::unordered_map<std::string, std::array<Float, 3>> &neumann_bcs,
+                                     Vector &vec) {
+        for (const auto &[physical_name, bc_value] : neumann_bcs) {
+            auto element_entities2 = _mesh.GetPhysicalEntity(physical_name, bc_dimension);
+            for (const auto &element_entity : element_entities2) {
+                auto element_inds = _mesh.GetEntity(bc_dimension, element_entity);
+                for (const auto &element_ind : element_inds) {
+                    auto element = _mesh.GetElement(bc_dimension, element_ind);
+                    if (!owns_element(*element)) {
+                        continue;
+                    }
+
+                    dofs.resize(3 * static_cast<size_t>(element->NumNodes()));
+                    element_forcing.setZero(3 * element->NumNodes());
+
+                    for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
+                        auto row = element->GetNodeIndex(ii);
+
+                        auto bc_value_copy = bc_value;
+                        for (Integer jj = 0; jj < 3; ++jj) {
+                            dofs[static_cast<size_t>(3 * ii + jj)] = 3 * row + jj;
+
+                            element_forcing(3 * ii + jj) =
+                                element->Integrate([element, ii, bc_value_copy, jj](const Coord &pos) -> Float {
+                                    return bc_value_copy[static_cast<size_t>(jj)] * element->ShapeFn(ii, pos);
+                                });
+                        }
+                    }
+
+                    vec.AddElementVector(dofs, element_forcing);
+                }
+            }
+        }
+    };
+
+    add_neumann_bcs(_input.neumann_bcs, forcing);
     stiffness.Assemble();
     forcing.Assemble();
 
-    // Solve stiffness matrix/forcing vector equation for displacement
-    Log::Info("Beginning linear solve");
-    auto displacement_vec = stiffness.Solve(forcing);
-    Log::Info("Finished linear solve");
+    if (_input.load_cases.empty()) {
+        // Solve stiffness matrix/forcing vector equation for displacement
+        Log::Info("Beginning linear solve");
+        auto displacement_vec = stiffness.Solve(forcing, _input.solver);
+        Log::Info("Finished linear solve");
 
-    // Transfer solution to mesh field
-    for (Integer ii = 0; ii < displacement_vec.Size() / 3; ++ii) {
+        // Every rank gets the whole solution:
+        SetFields(displacement_vec.GatherAll());
+        return;
+    }
+
+    // The load cases only differ in their forcing, so the preconditioner is set up once for all of them:
+    LinearSolver solver(stiffness, _input.solver);
+    Vector displacement_vec(pattern);
+    _loadCaseDisplacements.clear();
+    for (const auto &load_case : _input.load_cases) {
+        Vector case_forcing(forcing);
+        add_neumann_bcs(load_case.neumann_bcs, case_forcing);
+        case_forcing.Assemble();
+
+        Log::Info("Beginning linear solve of load case {}", load_case.name);
+        solver.Solve(case_forcing, displacement_vec);
+        Log::Info("Finished linear solve of load case {}", load_case.name);
+
+        _loadCaseDisplacements.push_back(displacement_vec.GatherAll());
+    }
+}
+
+void Mechanical::SetFields(const std::vector<Float> &displacement) {
+    constexpr auto dimension = 3;
+
+    const auto D = ElasticityMatrix(_input.youngs_modulus, _input.poisson_ratio);
+
+    // Transfer solution to mesh field:
+    _mesh.AddVectorField("displacement");
+    for (Integer ii = 0; ii < _mesh.GetNumNodes(); ++ii) {
+        const auto node = static_cast<size_t>(ii);
         _mesh.VectorFieldSetValue("displacement", ii,
-                                  {displacement_vec.GetValue(3 * ii), displacement_vec.GetValue(3 * ii + 1),
-                                   displacement_vec.GetValue(3 * ii + 2)});
+                                  {displacement[3 * node], displacement[3 * node + 1], displacement[3 * node + 2]});
     }
 
     // Loop over elements and compute the stress and strain:
     _mesh.AddTensorField("stress");
     _mesh.AddTensorField("strain");
     std::vector<Eigen::MatrixXd> stress_vec(static_cast<size_t>(_mesh.GetNumNodes()));
-    std::vector<Float> stress_count(static_cast<size_t>(_mesh.GetNumNodes()));
     std::vector<Eigen::MatrixXd> strain_vec(static_cast<size_t>(_mesh.GetNumNodes()));
-    std::vector<Float> strain_count(static_cast<size_t>(_mesh.GetNumNodes()));
 
     for (Integer ii = 0; ii < _mesh.GetNumNodes(); ++ii) {
         stress_vec[static_cast<size_t>(ii)] = Eigen::MatrixXd::Zero(6, 1);
-        stress_count[static_cast<size_t>(ii)] = 0.0;
         strain_vec[static_cast<size_t>(ii)] = Eigen::MatrixXd::Zero(6, 1);
-        strain_count[static_cast<size_t>(ii)] = 0.0;
     }
 
     // Average the nodal stress and strain with contributions from all elements that the node is in:
@@ -191,9 +326,9 @@ void Mechanical::Solve() {
 
                 // Extract the current displacement vector:
                 Eigen::MatrixXd disp = Eigen::MatrixXd::Zero(3, 1);
-                disp(0, 0) = displacement_vec.GetValue(3 * row);
-                disp(1, 0) = displacement_vec.GetValue(3 * row + 1);
-                disp(2, 0) = displacement_vec.GetValue(3 * row + 2);
+                disp(0, 0) = displacement[3 * static_cast<size_t>(row)];
+                disp(1, 0) = displacement[3 * static_cast<size_t>(row) + 1];
+                disp(2, 0) = displacement[3 * static_cast<size_t>(row) + 2];
 
                 Eigen::MatrixXd strain_local = Bb * disp;
 
@@ -203,17 +338,17 @@ void Mechanical::Solve() {
             }
 
             stress_vec[static_cast<size_t>(node_index)] += sigma;
-            stress_count[static_cast<size_t>(node_index)] += 1.0;
-
             strain_vec[static_cast<size_t>(node_index)] += strain;
-            strain_count[static_cast<size_t>(node_index)] += 1.0;
         }
     }
 
     // Transfer stress and strain to the mesh tensor field:
+    const auto &node_elements = _mesh.GetNodeElements(dimension);
     for (Integer ii = 0; ii < _mesh.GetNumNodes(); ++ii) {
+        const auto num_node_elements = static_cast<Float>(node_elements.Neighbors(ii).size());
+
         // Set stress:
-        stress_vec[static_cast<size_t>(ii)] /= stress_count[static_cast<size_t>(ii)];
+        stress_vec[static_cast<size_t>(ii)] /= num_node_elements;
 
         _mesh.TensorFieldSetValue("stress", ii,
                                   {stress_vec[static_cast<size_t>(ii)](0), stress_vec[static_cast<size_t>(ii)](1),
@@ -221,7 +356,7 @@ void Mechanical::Solve() {
                                    stress_vec[static_cast<size_t>(ii)](4), stress_vec[static_cast<size_t>(ii)](5)});
 
         // Set strain:
-        strain_vec[static_cast<size_t>(ii)] /= strain_count[static_cast<size_t>(ii)];
+        strain_vec[static_cast<size_t>(ii)] /= num_node_elements;
 
         _mesh.TensorFieldSetValue("strain", ii,
                                   {strain_vec[static_cast<size_t>(ii)](0), strain_vec[static_cast<size_t>(ii)](1),
@@ -230,4 +365,25 @@ void Mechanical::Solve() {
     }
 }
 
+void Mechanical::WriteVTK(const std::filesystem::path &output_filename) {
+    if (CommRank() != 0) {
+        return;
+    }
+
+    if (_input.load_cases.empty()) {
+        _mesh.WriteVTK(output_filename);
+        return;
+    }
+
+    Check(_loadCaseDisplacements.size() == _input.load_cases.size(), "The load cases haven't been solved yet");
+    for (size_t ii = 0; ii < _input.load_cases.size(); ++ii) {
+        SetFields(_loadCaseDisplacements[ii]);
+
+        auto case_filename = output_filename;
+        case_filename.replace_filename(output_filename.stem().string() + "_" + _input.load_cases[ii].name +
+                                       output_filename.extension().string());
+        _mesh.WriteVTK(case_filename);
+    }
+}
+
 } // namespace plasmatic
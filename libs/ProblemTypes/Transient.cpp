@@ -0,0 +1,88 @@
+#include "interface/ProblemTypes/Transient.h"
+
+#include <string>
+#include <utility>
+
+namespace plasmatic {
+
+namespace {
+
+// Sets the given owned rows of `to` to the entries of `from`, or to zero if `from` is null:
+void SetRows(Vector &to, std::span<const Integer> rows, const Vector *from) {
+    const auto start = to.OwnershipRange().first;
+    const auto to_values = to.View();
+    if (from == nullptr) {
+        for (const auto &row : rows) {
+            to_values[row - start] = 0.0;
+        }
+        return;
+    }
+
+    const auto from_values = from->View();
+    for (const auto &row : rows) {
+        to_values[row - start] = from_values[row - start];
+    }
+}
+
+} // namespace
+
+std::filesystem::path StepFilename(const std::filesystem::path &filename, Integer step) {
+    auto step_filename = filename;
+    step_filename.replace_filename(filename.stem().string() + "_" + std::to_string(step) +
+                                   filename.extension().string());
+
+    return step_filename;
+}
+
+void SolveTransientHeat(ElementAssembler &assembler, const ThetaKernel &kernel, std::span<const Integer> dirichlet_rows,
+                        const Vector &dirichlet_values, const Vector &forcing, const Vector &initial_temperature,
+                        const TransientOptions &options, const SolverOptions &solver, const TemperatureOutput &output) {
+    Check(options.method != TimeIntegration::Steady, "Steady state has no time steps");
+    Check(options.time_step > 0.0, "The time step must be positive: {}", options.time_step);
+    Check(options.num_time_steps >= 0, "The number of time steps must not be negative: {}", options.num_time_steps);
+    Check(options.output_interval > 0, "The output interval must be positive: {}", options.output_interval);
+
+    const auto theta = options.method == TimeIntegration::CrankNicolson ? 0.5 : 1.0;
+    const auto dt = options.time_step;
+    const auto &pattern = assembler.Pattern();
+
+    Matrix system(pattern);
+    assembler.AddElementMatrices(kernel(theta * dt), system);
+    system.Assemble();
+
+    Matrix explicit_part(pattern);
+    assembler.AddElementMatrices(kernel(-(1.0 - theta) * dt), explicit_part);
+    explicit_part.Assemble();
+
+    // The part of the right hand side that is the same every step: dt f on the free rows minus the constrained columns
+    // of the system times the Dirichlet values, and the Dirichlet values on the constrained rows:
+    Vector constant_rhs(forcing);
+    constant_rhs *= dt;
+    system.SetDirichletBCs(dirichlet_rows, dirichlet_values, constant_rhs);
+
+    Vector temperature(initial_temperature);
+    SetRows(temperature, dirichlet_rows, &dirichlet_values);
+
+    output({.step = 0, .time = 0.0, .temperature = temperature.GatherAll()});
+
+    LinearSolver linear_solver(system, solver);
+    Vector rhs(pattern);
+    Vector next_temperature(pattern);
+    for (Integer step = 1; step <= options.num_time_steps; ++step) {
+        explicit_part.Multiply(temperature, rhs);
+        SetRows(rhs, dirichlet_rows, nullptr);
+        rhs += constant_rhs;
+
+        linear_solver.Solve(rhs, next_temperature);
+        std::swap(temperature, next_temperature);
+
+        if (step % options.output_interval == 0 || step == options.num_time_steps) {
+            output({.step = step, .time = static_cast<Float>(step) * dt, .temperature = temperature.GatherAll()});
+        }
+    }
+
+    Log::Info("Finished {} time steps with {} preconditioner setup(s)", options.num_time_steps,
+              linear_solver.NumSetups());
+}
+
+} // namespace plasmatic
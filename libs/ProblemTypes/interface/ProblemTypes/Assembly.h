@@ -0,0 +1,75 @@
+#pragma once
+
+#include "LinearAlgebra/LinearAlgebra.h"
+#include "Mesh/Mesh.h"
+
+#include <Eigen/Dense>
+
+#include <functional>
+#include <vector>
+
+namespace plasmatic {
+
+// Walks the connectivity of the elements of the given dimension and counts the exact number of nonzero blocks in each
+// locally owned block row of a matrix with `dofs_per_node` unknowns per node (block size = dofs_per_node).
+SparsityPattern BuildSparsityPattern(const Mesh &mesh, Integer dimension, Integer dofs_per_node);
+
+// The rank that assembles an element: the one that owns most of its nodes in the pattern (the lowest one on ties).
+Integer ElementOwner(const SparsityPattern &pattern, const Element &element);
+
+// Adds the element matrices of the elements of one dimension into a global matrix, computing them on `num_threads`
+// threads (0 means one per hardware thread). The element dofs are ordered node by node with `dofs_per_node` dofs each.
+//
+// Rows are distributed over the ranks by node like the pattern, and every element is assembled only by the rank that
+// owns most of its nodes. Contributions to rows of other ranks are sent to them when the matrix is assembled.
+//
+// With more than one thread the elements are colored so that elements of the same color share no nodes. The threads
+// then add the element matrices of a color straight into a block CSR copy of the rows without any locks, and the rows
+// are handed to the matrix (which isn't thread safe) at the end.
+class ElementAssembler {
+  public:
+    using ElementKernel = std::function<void(const Element &element, Eigen::MatrixXd &element_matrix)>;
+
+    ElementAssembler(const Mesh &mesh, Integer dimension, Integer dofs_per_node, Integer num_threads);
+
+    const SparsityPattern &Pattern() const { return _pattern; }
+
+    Integer NumThreads() const { return _pool.NumThreads(); }
+
+    Integer NumColors() const { return static_cast<Integer>(_colors.size()); }
+
+    const std::vector<Integer> &OwnedElements() const { return _ownedElements; }
+
+    // Whether this rank assembles the element (which may also be of another dimension, e.g. a boundary element):
+    bool OwnsElement(const Element &element) const;
+
+    // Calls kernel for every owned element and adds the results to the matrix, which must have been created from
+    // Pattern(). The matrix still needs to be assembled afterwards (which also sends the rows of other ranks).
+    void AddElementMatrices(const ElementKernel &kernel, Matrix &matrix);
+
+  private:
+    void AddToRows(const Element &element, const Eigen::MatrixXd &element_matrix);
+
+    const Mesh &_mesh;
+    Integer _dimension;
+    Integer _dofsPerNode;
+    Integer _rank;
+
+    SparsityPattern _pattern;
+    ThreadPool _pool;
+
+    std::vector<Integer> _ownedElements;
+    std::vector<std::vector<Integer>> _colors;
+
+    // Block CSR of the owned rows followed by the ghost rows (the rows of other ranks that the owned elements touch).
+    // The values of every block row are stored like Matrix::AddBlockRow expects:
+    std::vector<Integer> _rows;
+    std::vector<Integer> _rowIndex;
+    std::vector<Integer> _rowOffsets;
+    std::vector<Integer> _columns;
+    std::vector<Float> _values;
+
+    std::vector<Eigen::MatrixXd> _elementMatrices;
+};
+
+} // namespace plasmatic
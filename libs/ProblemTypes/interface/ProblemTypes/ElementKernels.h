@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Mesh/Integrate.h"
+#include "Utility/Utility.h"
+
+#include <Eigen/Dense>
+
+namespace plasmatic {
+
+// Element kernels compute the whole local matrix of an element in a single pass over its quadrature points using
+// fixed-size matrices; use them through VisitElement to get the concrete element type.
+
+template <typename ElementType> auto ConductionStiffness(const ElementType &element, Float conductivity) {
+    using Quadrature = typename ElementType::Quadrature;
+    constexpr auto num_nodes = Quadrature::num_nodes;
+
+    const auto quadrature = element.EvaluateQuadrature();
+
+    Eigen::Matrix<Float, num_nodes, num_nodes> result = Eigen::Matrix<Float, num_nodes, num_nodes>::Zero();
+    for (size_t ii = 0; ii < static_cast<size_t>(Quadrature::num_points); ++ii) {
+        const auto &derivatives = quadrature.shape_fn_derivatives[ii];
+        result.noalias() += (conductivity * quadrature.weights[ii]) * derivatives.transpose() * derivatives;
+    }
+
+    return result;
+}
+
+// Consistent mass matrix (e.g. of the heat capacity) integrated with the quadrature of the element, which is too low an
+// order for it on triangles and quadratic elements and leaves it only positive semidefinite:
+template <typename ElementType> auto MassMatrix(const ElementType &element, Float density) {
+    using Quadrature = typename ElementType::Quadrature;
+    constexpr auto num_nodes = Quadrature::num_nodes;
+
+    const auto quadrature = element.EvaluateQuadrature();
+
+    Eigen::Matrix<Float, num_nodes, num_nodes> result = Eigen::Matrix<Float, num_nodes, num_nodes>::Zero();
+    for (size_t ii = 0; ii < static_cast<size_t>(Quadrature::num_points); ++ii) {
+        const auto &shape_fns = quadrature.shape_fns[ii];
+        result.noalias() += (density * quadrature.weights[ii]) * shape_fns * shape_fns.transpose();
+    }
+
+    return result;
+}
+
+// Strain--displacement matrix (Voigt notation, engineering shear strains) of all nodes at one quadrature point, with
+// the displacement dofs ordered node by node
+template <Integer NumNodes>
+Eigen::Matrix<Float, 6, 3 * NumNodes> StrainDisplacementMatrix(const Eigen::Matrix<Float, 3, NumNodes> &derivatives) {
+    Eigen::Matrix<Float, 6, 3 * NumNodes> B = Eigen::Matrix<Float, 6, 3 * NumNodes>::Zero();
+    for (Integer ii = 0; ii < NumNodes; ++ii) {
+        B(0, 3 * ii + 0) = derivatives(0, ii);
+        B(1, 3 * ii + 1) = derivatives(1, ii);
+        B(2, 3 * ii + 2) = derivatives(2, ii);
+        B(3, 3 * ii + 0) = derivatives(1, ii);
+        B(3, 3 * ii + 1) = derivatives(0, ii);
+        B(4, 3 * ii + 1) = derivatives(2, ii);
+        B(4, 3 * ii + 2) = derivatives(1, ii);
+        B(5, 3 * ii + 0) = derivatives(2, ii);
+        B(5, 3 * ii + 2) = derivatives(0, ii);
+    }
+
+    return B;
+}
+
+template <typename ElementType>
+auto ElasticStiffness(const ElementType &element, const Eigen::Matrix<Float, 6, 6> &elasticity) {
+    using Quadrature = typename ElementType::Quadrature;
+    constexpr auto num_dofs = 3 * Quadrature::num_nodes;
+    static_assert(Quadrature::dimension == 3, "Elastic stiffness is only implemented for volume elements");
+
+    const auto quadrature = element.EvaluateQuadrature();
+
+    Eigen::Matrix<Float, num_dofs, num_dofs> result = Eigen::Matrix<Float, num_dofs, num_dofs>::Zero();
+    for (size_t ii = 0; ii < static_cast<size_t>(Quadrature::num_points); ++ii) {
+        const auto B = StrainDisplacementMatrix(quadrature.shape_fn_derivatives[ii]);
+        result.noalias() += quadrature.weights[ii] * (B.transpose() * elasticity * B);
+    }
+
+    return result;
+}
+
+} // namespace plasmatic
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "LinearAlgebra/SolverOptions.h"
 #include "Mesh/Mesh.h"
+#include "Transient.h"
 
 #include <filesystem>
+#include <vector>
 
 namespace plasmatic {
 
@@ -13,15 +16,24 @@ class HeatEq3D {
         Float thermal_conductivity = std::numeric_limits<Float>::quiet_NaN();
         std::unordered_map<std::string, Float> dirichlet_bcs = {};
         std::unordered_map<std::string, Float> neumann_bcs = {};
+        Integer num_threads = 1;
+        bool mesh_cache = false;
+        NodeOrdering node_ordering = NodeOrdering::Original;
+        bool matrix_free = false;
+        SolverOptions solver = SymmetricSolverOptions();
+        TransientOptions transient = {};
     };
 
     HeatEq3D(const Input &input);
 
     void Solve();
 
-    void WriteVTK(const std::filesystem::path &output_filename) { _mesh.WriteVTK(output_filename); }
+    // Only written by the first rank. After a transient solve this is the temperature of the last step:
+    void WriteVTK(const std::filesystem::path &output_filename);
 
   private:
+    void SetTemperature(const std::vector<Float> &temperature);
+
     Input _input;
     Mesh _mesh;
 };
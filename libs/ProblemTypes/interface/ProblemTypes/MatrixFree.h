@@ -0,0 +1,78 @@
+#pragma once
+
+#include "LinearAlgebra/LinearAlgebra.h"
+#include "Mesh/Mesh.h"
+
+#include <Eigen/Dense>
+
+#include <span>
+#include <vector>
+
+namespace plasmatic {
+
+// Applies the stiffness matrix of the elements of one dimension without ever assembling it, for meshes whose assembled
+// matrix doesn't fit in memory. With one unknown per node it is the conduction stiffness and `material` the
+// conductivity tensor (dimension x dimension); with three unknowns per node it is the linear elastic stiffness and
+// `material` the 6x6 elasticity matrix in Voigt notation (see ElasticStiffness).
+//
+// Rows and elements are distributed over the ranks like in ElementAssembler. The quadrature weight and the inverse
+// Jacobian of every quadrature point of the owned elements are computed once and kept, and every product applies the
+// element matrices from them and the reference shape function derivatives. With more than one thread the elements are
+// colored so that the threads add to disjoint rows.
+class MatrixFreeOperator {
+  public:
+    MatrixFreeOperator(const Mesh &mesh, Integer dimension, Integer dofs_per_node, const Eigen::MatrixXd &material,
+                       Integer num_threads);
+
+    // Only holds the distribution of the rows, not their nonzeros:
+    const SparsityPattern &Pattern() const { return _pattern; }
+
+    // Whether this rank applies the element (which may also be of another dimension, e.g. a boundary element):
+    bool OwnsElement(const Element &element) const;
+
+    // A matrix-free Matrix that calls Apply and Diagonal. It refers to the operator, which must outlive it.
+    Matrix CreateMatrix();
+
+    // y = A x on the owned rows followed by the ghost rows (see MatrixFreeMult):
+    void Apply(std::span<const Float> x, std::span<Float> y);
+
+    void Diagonal(std::span<Float> diagonal);
+
+    // Memory used by the geometric factors and the element lists:
+    size_t MemoryBytes() const;
+
+  private:
+    // The owned elements of one element block of the mesh:
+    struct OwnedBlock {
+        size_t block;
+
+        // Indices into the block:
+        std::vector<Integer> elements;
+
+        // Weight followed by the inverse Jacobian (column major) of every quadrature point of every element:
+        std::vector<Float> factors;
+
+        // Positions in `elements` of every color (only with more than one thread):
+        std::vector<std::vector<Integer>> colors;
+    };
+
+    // Calls fn with the position of every owned element of the block, on the threads one color at a time:
+    template <typename Function> void ForEachElement(const OwnedBlock &owned, Function &&fn);
+
+    const Mesh &_mesh;
+    Integer _dimension;
+    Integer _dofsPerNode;
+    Integer _rank;
+    Eigen::MatrixXd _material;
+
+    SparsityPattern _pattern;
+    ThreadPool _pool;
+
+    std::vector<OwnedBlock> _blocks;
+
+    // Local (owned, then ghost) index of every node that the owned elements use, -1 for the others:
+    std::vector<Integer> _localNodes;
+    std::vector<Integer> _ghostRows;
+};
+
+} // namespace plasmatic
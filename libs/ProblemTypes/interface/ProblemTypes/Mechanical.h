@@ -1,30 +1,57 @@
 #pragma once
 
+#include "LinearAlgebra/Matrix.h"
+#include "LinearAlgebra/SolverOptions.h"
 #include "Mesh/Mesh.h"
 
 #include <filesystem>
+#include <string>
+#include <vector>
 
 namespace plasmatic {
 
 class Mechanical {
   public:
+    // Tractions that are solved for in addition to the Neumann conditions of the input:
+    struct LoadCase {
+        std::string name;
+        std::unordered_map<std::string, std::array<Float, 3>> neumann_bcs = {};
+    };
+
     struct Input {
         std::filesystem::path mesh_filename;
         Float youngs_modulus = std::numeric_limits<Float>::quiet_NaN();
         Float poisson_ratio = std::numeric_limits<Float>::quiet_NaN();
         std::unordered_map<std::string, std::array<Float, 3>> dirichlet_bcs = {};
         std::unordered_map<std::string, std::array<Float, 3>> neumann_bcs = {};
+        MatrixFormat matrix_format = MatrixFormat::BlockAIJ;
+        Integer num_threads = 1;
+        bool mesh_cache = false;
+        NodeOrdering node_ordering = NodeOrdering::Original;
+        bool matrix_free = false;
+        SolverOptions solver = SymmetricSolverOptions();
+
+        // Solved one after another with the same stiffness matrix and preconditioner (e.g. factorization):
+        std::vector<LoadCase> load_cases = {};
     };
 
     Mechanical(const Input &input);
 
     void Solve();
 
-    void WriteVTK(const std::filesystem::path &output_filename) { _mesh.WriteVTK(output_filename); }
+    // Only written by the first rank. With load cases every case is written to <stem>_<case name><extension> of the
+    // given file name instead:
+    void WriteVTK(const std::filesystem::path &output_filename);
 
   private:
+    // Sets the displacement, stress and strain fields of the mesh from the displacements of all nodes:
+    void SetFields(const std::vector<Float> &displacement);
+
     Input _input;
     Mesh _mesh;
+
+    // The displacements of all nodes of every load case:
+    std::vector<std::vector<Float>> _loadCaseDisplacements;
 };
 
 } // namespace plasmatic
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "Assembly.h"
+#include "ElementKernels.h"
 #include "HeatEq2D.h"
 #include "HeatEq3D.h"
+#include "MatrixFree.h"
 #include "Mechanical.h"
+#include "Transient.h"
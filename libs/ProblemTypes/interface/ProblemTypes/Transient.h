@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Assembly.h"
+
+#include "LinearAlgebra/LinearAlgebra.h"
+
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace plasmatic {
+
+enum class TimeIntegration { Steady, BackwardEuler, CrankNicolson };
+
+// Time stepping of the heat equation, heat_capacity dT/dt = div(k grad T), with fixed boundary conditions. The
+// temperature is kept every output_interval steps and after the last one.
+struct TransientOptions {
+    TimeIntegration method = TimeIntegration::Steady;
+    Float heat_capacity = 1.0;
+    Float initial_temperature = 0.0; // uniform, for the heat problems
+    Float time_step = 0.0;
+    Integer num_time_steps = 0;
+    Integer output_interval = 1;
+
+    // The heat problems write every kept step to StepFilename(output_filename, step) as soon as it is computed, unless
+    // this is empty:
+    std::filesystem::path output_filename = {};
+};
+
+struct TemperatureSnapshot {
+    Integer step;
+    Float time;
+
+    // The temperature of all nodes:
+    std::vector<Float> temperature;
+};
+
+// Called on every rank with the initial temperature and every kept step:
+using TemperatureOutput = std::function<void(const TemperatureSnapshot &snapshot)>;
+
+// The element kernel of the mass matrix plus `stiffness_factor` times the stiffness matrix:
+using ThetaKernel = std::function<ElementAssembler::ElementKernel(Float stiffness_factor)>;
+
+// <stem>_<step><extension> of the given file name:
+std::filesystem::path StepFilename(const std::filesystem::path &filename, Integer step);
+
+// Advances M dT/dt + K T = f with the theta method, solving (M + theta dt K) T' = (M - (1 - theta) dt K) T + dt f
+// every step (theta is 1 for backward Euler and 1/2 for Crank-Nicolson). Both matrices are assembled once, and the
+// preconditioner (or factorization) of the left one is set up once for all steps. `dirichlet_rows` are the owned rows
+// with a Dirichlet condition (duplicates are fine), whose values are in `dirichlet_values` and replace those of
+// `initial_temperature`, and `forcing` is f. Every kept step is handed to `output` when it is computed and not stored.
+void SolveTransientHeat(ElementAssembler &assembler, const ThetaKernel &kernel, std::span<const Integer> dirichlet_rows,
+                        const Vector &dirichlet_values, const Vector &forcing, const Vector &initial_temperature,
+                        const TransientOptions &options, const SolverOptions &solver, const TemperatureOutput &output);
+
+} // namespace plasmatic
@@ -0,0 +1,179 @@
+#include "LinearAlgebra/LinearAlgebra.h"
+#include "ProblemTypes/ProblemTypes.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace plasmatic {
+namespace {
+
+// Cells per side of the generated cubes, which PLASMATIC_SCALING_SIZES (e.g. "32,64,128") overrides to run the large
+// meshes (128 cells per side are 6.4 million unknowns):
+std::vector<Integer> CubeSizes() {
+    const auto *sizes = std::getenv("PLASMATIC_SCALING_SIZES");
+    if (sizes == nullptr) {
+        return {4, 8, 16};
+    }
+
+    std::vector<Integer> result;
+    std::stringstream stream(sizes);
+    std::string size;
+    while (std::getline(stream, size, ',')) {
+        result.push_back(std::stoi(size));
+    }
+
+    return result;
+}
+
+// Writes the unit cube split into cells^3 cubes of six tetrahedra each as a Gmsh 4.1 mesh:
+void WriteCubeMesh(const std::filesystem::path &filename, Integer cells) {
+    const auto points = cells + 1;
+    const auto num_nodes = points * points * points;
+    const auto num_elements = 6 * cells * cells * cells;
+
+    std::ofstream out(filename);
+    out << "$MeshFormat\n4.1 0 8\n$EndMeshFormat\n";
+    out << "$PhysicalNames\n1\n3 1 \"volume\"\n$EndPhysicalNames\n";
+    out << "$Entities\n0 0 0 1\n1 0 0 0 1 1 1 1 1 0\n$EndEntities\n";
+
+    out << "$Nodes\n1 " << num_nodes << " 1 " << num_nodes << "\n3 1 0 " << num_nodes << "\n";
+    for (Integer ii = 1; ii <= num_nodes; ++ii) {
+        out << ii << "\n";
+    }
+
+    const auto spacing = 1.0 / static_cast<Float>(cells);
+    for (Integer kk = 0; kk < points; ++kk) {
+        for (Integer jj = 0; jj < points; ++jj) {
+            for (Integer ii = 0; ii < points; ++ii) {
+                out << static_cast<Float>(ii) * spacing << " " << static_cast<Float>(jj) * spacing << " "
+                    << static_cast<Float>(kk) * spacing << "\n";
+            }
+        }
+    }
+    out << "$EndNodes\n";
+
+    // The six tetrahedra around the diagonal from corner 0 to corner 7 of a cube:
+    constexpr std::array<std::array<size_t, 4>, 6> tetrahedra = {
+        {{0, 1, 3, 7}, {0, 1, 5, 7}, {0, 2, 3, 7}, {0, 2, 6, 7}, {0, 4, 5, 7}, {0, 4, 6, 7}}};
+
+    out << "$Elements\n1 " << num_elements << " 1 " << num_elements << "\n3 1 4 " << num_elements << "\n";
+    Integer element_id = 1;
+    for (Integer kk = 0; kk < cells; ++kk) {
+        for (Integer jj = 0; jj < cells; ++jj) {
+            for (Integer ii = 0; ii < cells; ++ii) {
+                std::array<Integer, 8> corners = {};
+                for (Integer corner = 0; corner < 8; ++corner) {
+                    const auto x_index = ii + (corner & 1);
+                    const auto y_index = jj + ((corner >> 1) & 1);
+                    const auto z_index = kk + ((corner >> 2) & 1);
+                    corners[static_cast<size_t>(corner)] = 1 + x_index + points * (y_index + points * z_index);
+                }
+
+                for (const auto &tetrahedron : tetrahedra) {
+                    out << element_id++;
+                    for (const auto &corner : tetrahedron) {
+                        out << " " << corners[corner];
+                    }
+                    out << "\n";
+                }
+            }
+        }
+    }
+    out << "$EndElements\n";
+}
+} // namespace
+
+// Iterations of CG with algebraic multigrid for a cube that is clamped on one side and pulled down by its weight, with
+// and without the rigid body modes. With them the iterations should stay about the same as the mesh is refined.
+TEST(ProblemTypesTest, ElasticityScalingBenchmark) {
+    constexpr Integer dimension = 3;
+    constexpr Integer dofs_per_node = 3;
+
+    constexpr Float poisson_ratio = 0.3;
+    constexpr Float lame_lambda = poisson_ratio / ((1.0 + poisson_ratio) * (1.0 - 2.0 * poisson_ratio));
+    constexpr Float lame_mu = 1.0 / (2.0 * (1.0 + poisson_ratio));
+
+    Eigen::Matrix<Float, 6, 6> D = Eigen::Matrix<Float, 6, 6>::Zero();
+    D.topLeftCorner<3, 3>().setConstant(lame_lambda);
+    D.diagonal() << lame_lambda + 2.0 * lame_mu, lame_lambda + 2.0 * lame_mu, lame_lambda + 2.0 * lame_mu, lame_mu,
+        lame_mu, lame_mu;
+
+    const ElementAssembler::ElementKernel kernel = [&D](const Element &element, Eigen::MatrixXd &element_matrix) {
+        VisitElement<dimension>(element, [&element_matrix, &D](const auto &typed_element) {
+            element_matrix = ElasticStiffness(typed_element, D);
+        });
+    };
+
+    std::vector<Integer> iterations;
+    for (const auto cells : CubeSizes()) {
+        const auto filename = "cube_" + std::to_string(cells) + ".msh";
+        if (CommRank() == 0) {
+            WriteCubeMesh(filename, cells);
+        }
+        MPI_Barrier(PETSC_COMM_WORLD);
+
+        Mesh mesh(filename);
+
+        ElementAssembler assembler(mesh, dimension, dofs_per_node, 1);
+        const auto &pattern = assembler.Pattern();
+        Matrix stiffness(pattern, MatrixFormat::BlockAIJ);
+        assembler.AddElementMatrices(kernel, stiffness);
+        stiffness.Assemble();
+
+        Vector forcing(pattern);
+        Vector clamped(pattern);
+        Vector coordinates(pattern);
+        std::vector<Integer> clamped_rows;
+        const auto cell_volume = 1.0 / static_cast<Float>(cells * cells * cells);
+        {
+            const auto forcing_values = forcing.View();
+            const auto coordinate_values = coordinates.View();
+            for (auto node = pattern.BlockRowStart(); node < pattern.BlockRowEnd(); ++node) {
+                const auto position = mesh.GetNodePosition(node);
+                const auto row = dofs_per_node * (node - pattern.BlockRowStart());
+                coordinate_values[row] = position.x;
+                coordinate_values[row + 1] = position.y;
+                coordinate_values[row + 2] = position.z;
+
+                if (position.x == 0.0) {
+                    for (Integer ii = 0; ii < dofs_per_node; ++ii) {
+                        clamped_rows.push_back(dofs_per_node * node + ii);
+                    }
+                } else {
+                    forcing_values[row + 1] = -cell_volume;
+                }
+            }
+        }
+
+        stiffness.SetDirichletBCs(clamped_rows, clamped, forcing);
+
+        const auto options = SymmetricSolverOptions();
+        const auto solve = [&]() {
+            const auto start = std::chrono::steady_clock::now();
+            stiffness.Solve(forcing, options);
+            const std::chrono::duration<Float> elapsed = std::chrono::steady_clock::now() - start;
+
+            EXPECT_LT(stiffness.SolveIterations(), options.max_iterations);
+            return std::pair{stiffness.SolveIterations(), elapsed.count()};
+        };
+
+        const auto [plain_iterations, plain_seconds] = solve();
+        stiffness.SetRigidBodyModes(coordinates);
+        const auto [rigid_body_iterations, rigid_body_seconds] = solve();
+        iterations.push_back(rigid_body_iterations);
+
+        Log::Info("{:>9} unknowns: {:>4} iterations ({:.2f} s) without and {:>4} ({:.2f} s) with the rigid body modes",
+                  stiffness.Rows(), plain_iterations, plain_seconds, rigid_body_iterations, rigid_body_seconds);
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    EXPECT_LE(iterations.back(), 2 * iterations.front() + 10);
+}
+
+} // namespace plasmatic
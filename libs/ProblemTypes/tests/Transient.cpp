@@ -0,0 +1,207 @@
+#include "LinearAlgebra/LinearAlgebra.h"
+#include "Mesh/Integrate.h"
+#include "ProblemTypes/ProblemTypes.h"
+
+#include <Eigen/Eigenvalues>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+namespace plasmatic {
+namespace {
+
+constexpr Integer dimension = 3;
+constexpr Float conductivity = 1.0;
+
+// The bar of mesh3d.msh runs along z from "load" (z = 0) to "fixed" (z = 1). With both ends held at zero and insulated
+// sides it cools like a rod, heat_capacity dT/dt = conductivity d^2T/dz^2.
+Mesh BarMesh() { return Mesh(GetExecutablePath() / "assets/ProblemTypes/mesh3d.msh"); }
+
+// Whether every node lies on one of the ends of the bar:
+std::vector<bool> EndNodes(const Mesh &mesh) {
+    std::vector<bool> end_nodes(static_cast<size_t>(mesh.GetNumNodes()), false);
+    for (const auto *name : {"load", "fixed"}) {
+        for (const auto &entity : mesh.GetPhysicalEntity(name, dimension - 1)) {
+            for (const auto &element_id : mesh.GetEntity(dimension - 1, entity)) {
+                auto element = mesh.GetElement(dimension - 1, element_id);
+                for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
+                    end_nodes[static_cast<size_t>(element->GetNodeIndex(ii))] = true;
+                }
+            }
+        }
+    }
+
+    return end_nodes;
+}
+
+ThetaKernel BarKernel(Float heat_capacity) {
+    return [heat_capacity](Float stiffness_factor) -> ElementAssembler::ElementKernel {
+        return [heat_capacity, stiffness_factor](const Element &element, Eigen::MatrixXd &element_matrix) {
+            VisitElement<dimension>(element, [&](const auto &typed_element) {
+                element_matrix = MassMatrix(typed_element, heat_capacity) +
+                                 stiffness_factor * ConductionStiffness(typed_element, conductivity);
+            });
+        };
+    };
+}
+
+// Advances the temperature of the bar from `initial` (of all nodes) with a direct solver, so that only the time
+// integration error is left:
+void SolveBar(const Mesh &mesh, const std::vector<Float> &initial, const TransientOptions &options,
+              const TemperatureOutput &output) {
+    ElementAssembler assembler(mesh, dimension, 1, 1);
+    const auto &pattern = assembler.Pattern();
+    const auto end_nodes = EndNodes(mesh);
+
+    std::vector<Integer> dirichlet_rows;
+    Vector initial_temperature(pattern);
+    for (Integer node = 0; node < mesh.GetNumNodes(); ++node) {
+        if (!pattern.OwnsBlockRow(node)) {
+            continue;
+        }
+
+        initial_temperature.SetValue(node, initial[static_cast<size_t>(node)]);
+        if (end_nodes[static_cast<size_t>(node)]) {
+            dirichlet_rows.push_back(node);
+        }
+    }
+    initial_temperature.Assemble();
+
+    auto solver = SymmetricSolverOptions();
+    solver.method = KrylovMethod::PreOnly;
+    solver.preconditioner = Preconditioner::Cholesky;
+
+    const Vector zero(pattern);
+    SolveTransientHeat(assembler, BarKernel(options.heat_capacity), dirichlet_rows, zero, zero, initial_temperature,
+                       options, solver, output);
+}
+
+} // namespace
+
+TEST(ProblemTypesTest, Transient_cooling) {
+    const auto mesh = BarMesh();
+
+    // A half sine keeps its shape and decays with exp(-pi^2 conductivity t / heat_capacity):
+    std::vector<Float> initial;
+    for (Integer node = 0; node < mesh.GetNumNodes(); ++node) {
+        initial.push_back(std::sin(std::numbers::pi * mesh.GetNodePosition(node).z));
+    }
+
+    const TransientOptions options = {.method = TimeIntegration::CrankNicolson,
+                                      .heat_capacity = 2.0,
+                                      .initial_temperature = 0.0,
+                                      .time_step = 0.01,
+                                      .num_time_steps = 20,
+                                      .output_interval = 5,
+                                      .output_filename = {}};
+
+    // The mesh has about ten elements along the bar, which limits the agreement to under a percent of the amplitude:
+    constexpr Float tolerance = 0.01;
+
+    std::vector<Integer> steps;
+    SolveBar(mesh, initial, options, [&](const TemperatureSnapshot &snapshot) {
+        steps.push_back(snapshot.step);
+        EXPECT_DOUBLE_EQ(snapshot.time, static_cast<Float>(snapshot.step) * options.time_step);
+
+        const auto decay = std::exp(-std::numbers::pi * std::numbers::pi * conductivity * snapshot.time /
+                                    options.heat_capacity);
+        ASSERT_EQ(snapshot.temperature.size(), initial.size());
+        for (size_t node = 0; node < initial.size(); ++node) {
+            EXPECT_NEAR(snapshot.temperature[node], decay * initial[node], tolerance)
+                << "step = " << snapshot.step << ", node = " << node;
+        }
+    });
+
+    EXPECT_EQ(steps, (std::vector<Integer>{0, 5, 10, 15, 20}));
+}
+
+TEST(ProblemTypesTest, Transient_convergence_order) {
+    const auto mesh = BarMesh();
+    const auto end_nodes = EndNodes(mesh);
+
+    constexpr Float heat_capacity = 1.0;
+
+    // The dense mass and stiffness matrices of the free nodes:
+    std::vector<Integer> free_index(static_cast<size_t>(mesh.GetNumNodes()), -1);
+    Integer num_free = 0;
+    for (size_t node = 0; node < free_index.size(); ++node) {
+        if (!end_nodes[node]) {
+            free_index[node] = num_free++;
+        }
+    }
+
+    Eigen::MatrixXd mass = Eigen::MatrixXd::Zero(num_free, num_free);
+    Eigen::MatrixXd stiffness = Eigen::MatrixXd::Zero(num_free, num_free);
+    for (Integer element_id = 0; element_id < mesh.GetNumElements(dimension); ++element_id) {
+        auto element = mesh.GetElement(dimension, element_id);
+        VisitElement<dimension>(*element, [&](const auto &typed_element) {
+            const auto element_mass = MassMatrix(typed_element, heat_capacity);
+            const auto element_stiffness = ConductionStiffness(typed_element, conductivity);
+            for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
+                const auto row = free_index[static_cast<size_t>(element->GetNodeIndex(ii))];
+                for (Integer jj = 0; jj < element->NumNodes(); ++jj) {
+                    const auto column = free_index[static_cast<size_t>(element->GetNodeIndex(jj))];
+                    if (row >= 0 && column >= 0) {
+                        mass(row, column) += element_mass(ii, jj);
+                        stiffness(row, column) += element_stiffness(ii, jj);
+                    }
+                }
+            }
+        });
+    }
+
+    // The slowest mode of M dT/dt = -K T decays exactly with exp(-lambda t), so the difference to it after a fixed time
+    // is the error of the time integration alone:
+    const Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> modes(stiffness, mass);
+    const auto lambda = modes.eigenvalues()(0);
+    Eigen::VectorXd mode = modes.eigenvectors().col(0);
+    mode /= mode.cwiseAbs().maxCoeff();
+
+    std::vector<Float> initial(free_index.size(), 0.0);
+    for (size_t node = 0; node < free_index.size(); ++node) {
+        if (free_index[node] >= 0) {
+            initial[node] = mode(free_index[node]);
+        }
+    }
+
+    constexpr Float end_time = 0.1;
+    for (const auto &[method, order] :
+         {std::pair{TimeIntegration::BackwardEuler, 1.0}, std::pair{TimeIntegration::CrankNicolson, 2.0}}) {
+        std::vector<Float> errors;
+        for (const auto num_time_steps : {5, 10, 20}) {
+            const TransientOptions options = {.method = method,
+                                              .heat_capacity = heat_capacity,
+                                              .initial_temperature = 0.0,
+                                              .time_step = end_time / static_cast<Float>(num_time_steps),
+                                              .num_time_steps = num_time_steps,
+                                              .output_interval = num_time_steps,
+                                              .output_filename = {}};
+
+            Float error = 0.0;
+            SolveBar(mesh, initial, options, [&](const TemperatureSnapshot &snapshot) {
+                if (snapshot.step != num_time_steps) {
+                    return;
+                }
+
+                for (size_t node = 0; node < free_index.size(); ++node) {
+                    const auto exact = std::exp(-lambda * end_time) * initial[node];
+                    error = std::max(error, std::abs(snapshot.temperature[node] - exact));
+                }
+            });
+
+            errors.push_back(error);
+        }
+
+        // Halving the time step divides the error by 2^order:
+        for (size_t ii = 1; ii < errors.size(); ++ii) {
+            EXPECT_NEAR(std::log2(errors[ii - 1] / errors[ii]), order, 0.1)
+                << "theta method with order " << order << ", errors " << errors[ii - 1] << " and " << errors[ii];
+        }
+    }
+}
+
+} // namespace plasmatic
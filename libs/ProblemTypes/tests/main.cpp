@@ -1,15 +1,287 @@
 #include "LinearAlgebra/LinearAlgebra.h"
+#include "Mesh/Integrate.h"
 #include "ProblemTypes/ProblemTypes.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
 namespace plasmatic {
 
+TEST(ProblemTypesTest, SparsityPattern) {
+    Mesh mesh(GetExecutablePath() / "assets/ProblemTypes/mesh2d.msh");
+
+    // For a triangulation of a simply connected domain the number of edges is N + T - 1 (Euler's formula), and every
+    // row has a diagonal entry plus one entry for each edge touching the node:
+    const auto num_nodes = mesh.GetNumNodes();
+    const auto num_triangles = mesh.GetNumElements(2);
+    const auto expected_nonzeros = num_nodes + 2 * (num_nodes + num_triangles - 1);
+
+    for (Integer dofs_per_node = 1; dofs_per_node <= 3; ++dofs_per_node) {
+        auto pattern = BuildSparsityPattern(mesh, 2, dofs_per_node);
+
+        EXPECT_EQ(pattern.GlobalRows(), dofs_per_node * num_nodes);
+        EXPECT_EQ(pattern.BlockSize(), dofs_per_node);
+
+        Integer nonzeros = 0;
+        for (size_t ii = 0; ii < pattern.DiagonalNonzeros().size(); ++ii) {
+            nonzeros += pattern.DiagonalNonzeros()[ii] + pattern.OffDiagonalNonzeros()[ii];
+        }
+
+        EXPECT_EQ(nonzeros, expected_nonzeros);
+    }
+}
+
+TEST(ProblemTypesTest, TemplatedIntegrate) {
+    Mesh mesh(GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh");
+
+    constexpr auto dimension = 3;
+
+    // Laplacian element matrices through the virtual, type-erased path:
+    const auto virtual_start = std::chrono::steady_clock::now();
+    std::vector<Eigen::MatrixXd> expected(static_cast<size_t>(mesh.GetNumElements(dimension)));
+    for (Integer element_id = 0; element_id < mesh.GetNumElements(dimension); ++element_id) {
+        auto element = mesh.GetElement(dimension, element_id);
+
+        auto &element_matrix = expected[static_cast<size_t>(element_id)];
+        element_matrix.setZero(element->NumNodes(), element->NumNodes());
+        for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
+            for (Integer jj = 0; jj < element->NumNodes(); ++jj) {
+                element_matrix(ii, jj) = element->Integrate([element, ii, jj](const Coord &pos) -> Float {
+                    return element->ShapeFnDerivative(ii, 0, pos) * element->ShapeFnDerivative(jj, 0, pos) +
+                           element->ShapeFnDerivative(ii, 1, pos) * element->ShapeFnDerivative(jj, 1, pos) +
+                           element->ShapeFnDerivative(ii, 2, pos) * element->ShapeFnDerivative(jj, 2, pos);
+                });
+            }
+        }
+    }
+    const auto virtual_end = std::chrono::steady_clock::now();
+
+    // The same matrices through the templated path:
+    const auto templated_start = std::chrono::steady_clock::now();
+    std::vector<Eigen::MatrixXd> actual(static_cast<size_t>(mesh.GetNumElements(dimension)));
+    for (Integer element_id = 0; element_id < mesh.GetNumElements(dimension); ++element_id) {
+        auto element = mesh.GetElement(dimension, element_id);
+
+        auto &element_matrix = actual[static_cast<size_t>(element_id)];
+        element_matrix.setZero(element->NumNodes(), element->NumNodes());
+        VisitElement<dimension>(*element, [&element_matrix](const auto &typed_element) {
+            const auto quadrature = typed_element.EvaluateQuadrature();
+            for (Integer ii = 0; ii < typed_element.NumNodes(); ++ii) {
+                for (Integer jj = 0; jj < typed_element.NumNodes(); ++jj) {
+                    element_matrix(ii, jj) = Integrate(quadrature, [ii, jj](const auto &values, size_t point) {
+                        const auto &derivatives = values.shape_fn_derivatives[point];
+                        return derivatives.col(ii).dot(derivatives.col(jj));
+                    });
+                }
+            }
+        });
+    }
+    const auto templated_end = std::chrono::steady_clock::now();
+
+    for (size_t ii = 0; ii < expected.size(); ++ii) {
+        EXPECT_LT((expected[ii] - actual[ii]).norm(), 1.0e-10 * expected[ii].norm()) << "element = " << ii;
+    }
+
+    const auto virtual_ms = std::chrono::duration<Float, std::milli>(virtual_end - virtual_start).count();
+    const auto templated_ms = std::chrono::duration<Float, std::milli>(templated_end - templated_start).count();
+    Log::Info("Element matrices: virtual Integrate {:.2f} ms, templated Integrate {:.2f} ms ({:.1f}x speedup)",
+              virtual_ms, templated_ms, virtual_ms / templated_ms);
+}
+
+TEST(ProblemTypesTest, ElementKernels) {
+    Mesh mesh(GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh");
+
+    constexpr auto dimension = 3;
+    constexpr auto v = 0.3;
+    constexpr auto constant = 1.0 / ((1.0 + v) * (1.0 - 2.0 * v));
+
+    Eigen::Matrix<Float, 6, 6> D = Eigen::Matrix<Float, 6, 6>::Zero();
+    D.topLeftCorner<3, 3>().setConstant(constant * v);
+    D.diagonal() << constant * (1.0 - v), constant * (1.0 - v), constant * (1.0 - v), constant * 0.5 * (1.0 - 2.0 * v),
+        constant * 0.5 * (1.0 - 2.0 * v), constant * 0.5 * (1.0 - 2.0 * v);
+
+    for (Integer element_id = 0; element_id < mesh.GetNumElements(dimension); ++element_id) {
+        auto element = mesh.GetElement(dimension, element_id);
+
+        // Node pair by node pair through the virtual Integrate:
+        Eigen::MatrixXd expected = Eigen::MatrixXd::Zero(3 * element->NumNodes(), 3 * element->NumNodes());
+        for (Integer ii = 0; ii < element->NumNodes(); ++ii) {
+            for (Integer jj = 0; jj < element->NumNodes(); ++jj) {
+                expected.block<3, 3>(3 * ii, 3 * jj) = element->Integrate(
+                    [element, ii, jj, &D](const Coord &pos) -> Eigen::MatrixXd {
+                        Eigen::MatrixXd Ba = Eigen::MatrixXd::Zero(6, 3);
+                        Eigen::MatrixXd Bb = Eigen::MatrixXd::Zero(6, 3);
+                        for (const auto &[B, node] : {std::pair{&Ba, ii}, std::pair{&Bb, jj}}) {
+                            (*B)(0, 0) = element->ShapeFnDerivative(node, 0, pos);
+                            (*B)(1, 1) = element->ShapeFnDerivative(node, 1, pos);
+                            (*B)(2, 2) = element->ShapeFnDerivative(node, 2, pos);
+                            (*B)(3, 0) = element->ShapeFnDerivative(node, 1, pos);
+                            (*B)(3, 1) = element->ShapeFnDerivative(node, 0, pos);
+                            (*B)(4, 1) = element->ShapeFnDerivative(node, 2, pos);
+                            (*B)(4, 2) = element->ShapeFnDerivative(node, 1, pos);
+                            (*B)(5, 0) = element->ShapeFnDerivative(node, 2, pos);
+                            (*B)(5, 2) = element->ShapeFnDerivative(node, 0, pos);
+                        }
+
+                        return Ba.transpose() * D * Bb;
+                    },
+                    3, 3);
+            }
+        }
+
+        VisitElement<dimension>(*element, [&expected, &D, element_id](const auto &typed_element) {
+            const auto actual = ElasticStiffness(typed_element, D);
+            EXPECT_LT((expected - actual).norm(), 1.0e-10 * expected.norm()) << "element = " << element_id;
+
+            const auto conduction = ConductionStiffness(typed_element, 2.0);
+            EXPECT_LT(conduction.rowwise().sum().norm(), 1.0e-10 * conduction.norm()) << "element = " << element_id;
+        });
+    }
+}
+
+TEST(ProblemTypesTest, MassMatrix) {
+    constexpr Float heat_capacity = 2.5;
+
+    // The shape functions sum to one, so the entries of the mass matrix sum to the heat capacity times the size of the
+    // element. The corner nodes come first and the edges are straight, so the size follows from the corners:
+    const auto expect_sum = [](const auto &mass, Float size, Integer element_id) {
+        EXPECT_NEAR(mass.sum(), heat_capacity * size, 1.0e-12 * heat_capacity * size) << "element = " << element_id;
+        EXPECT_LT((mass - mass.transpose()).norm(), 1.0e-14 * mass.norm()) << "element = " << element_id;
+    };
+
+    for (const auto *filename : {"mesh3d.msh", "mesh3d_quadratic.msh"}) {
+        Mesh mesh(GetExecutablePath() / "assets/ProblemTypes" / filename);
+
+        constexpr auto dimension = 3;
+        for (Integer element_id = 0; element_id < mesh.GetNumElements(dimension); ++element_id) {
+            auto element = mesh.GetElement(dimension, element_id);
+
+            const auto origin = mesh.GetNodePosition(element->GetNodeIndex(0));
+            Eigen::Matrix3d edges;
+            for (Integer ii = 0; ii < dimension; ++ii) {
+                const auto corner = mesh.GetNodePosition(element->GetNodeIndex(ii + 1));
+                edges.col(ii) << corner.x - origin.x, corner.y - origin.y, corner.z - origin.z;
+            }
+            const auto volume = std::abs(edges.determinant()) / 6.0;
+
+            VisitElement<dimension>(*element, [&](const auto &typed_element) {
+                expect_sum(MassMatrix(typed_element, heat_capacity), volume, element_id);
+            });
+        }
+    }
+
+    for (const auto *filename : {"mesh2d.msh", "mesh2d_quadratic.msh"}) {
+        Mesh mesh(GetExecutablePath() / "assets/ProblemTypes" / filename);
+
+        constexpr auto dimension = 2;
+        for (Integer element_id = 0; element_id < mesh.GetNumElements(dimension); ++element_id) {
+            auto element = mesh.GetElement(dimension, element_id);
+
+            const auto origin = mesh.GetNodePosition(element->GetNodeIndex(0));
+            const auto corner1 = mesh.GetNodePosition(element->GetNodeIndex(1));
+            const auto corner2 = mesh.GetNodePosition(element->GetNodeIndex(2));
+            const auto area = 0.5 * std::abs((corner1.x - origin.x) * (corner2.y - origin.y) -
+                                             (corner2.x - origin.x) * (corner1.y - origin.y));
+
+            VisitElement<dimension>(*element, [&](const auto &typed_element) {
+                expect_sum(MassMatrix(typed_element, heat_capacity), area, element_id);
+            });
+        }
+    }
+}
+
+TEST(ProblemTypesTest, ParallelAssembly) {
+    Mesh mesh(GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh");
+
+    constexpr Integer dimension = 3;
+    constexpr Integer dofs_per_node = 3;
+
+    Eigen::Matrix<Float, 6, 6> D = Eigen::Matrix<Float, 6, 6>::Identity();
+    D.topLeftCorner<3, 3>() += Eigen::Matrix<Float, 3, 3>::Constant(0.5);
+
+    const ElementAssembler::ElementKernel kernel = [&D](const Element &element, Eigen::MatrixXd &element_matrix) {
+        VisitElement<dimension>(element, [&element_matrix, &D](const auto &typed_element) {
+            element_matrix = ElasticStiffness(typed_element, D);
+        });
+    };
+
+    Vector x(dofs_per_node * mesh.GetNumNodes(), dofs_per_node);
+    for (Integer ii = 0; ii < x.Size(); ++ii) {
+        x.SetValue(ii, 1.0 + static_cast<Float>(ii % 11));
+    }
+    x.Assemble();
+
+    // The threaded assembly has to produce the same matrix as the serial one (up to summation order):
+    std::vector<Float> reference;
+    Float scale = 0.0;
+    for (const auto num_threads : {1, 2, 4, 8}) {
+        ElementAssembler assembler(mesh, dimension, dofs_per_node, num_threads);
+        EXPECT_EQ(assembler.NumThreads(), num_threads);
+
+        Matrix stiffness(assembler.Pattern(), MatrixFormat::BlockAIJ);
+
+        const auto start = std::chrono::steady_clock::now();
+        assembler.AddElementMatrices(kernel, stiffness);
+        stiffness.Assemble();
+        const auto end = std::chrono::steady_clock::now();
+
+        Log::Info("Assembly on {} threads ({} colors): {:.2f} ms", num_threads, assembler.NumColors(),
+                  std::chrono::duration<Float, std::milli>(end - start).count());
+
+        EXPECT_EQ(stiffness.GetInfo().mallocs, 0.0);
+
+        auto y = stiffness * x;
+        if (reference.empty()) {
+            for (Integer ii = 0; ii < y.Size(); ++ii) {
+                reference.push_back(y.GetValue(ii));
+                scale = std::max(scale, std::abs(reference.back()));
+            }
+            continue;
+        }
+
+        for (Integer ii = 0; ii < y.Size(); ++ii) {
+            EXPECT_NEAR(y.GetValue(ii), reference[static_cast<size_t>(ii)], 1.0e-12 * scale);
+        }
+    }
+}
+
+TEST(ProblemTypesTest, ElementOwnership) {
+    Mesh mesh(GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh");
+
+    constexpr Integer dimension = 3;
+    ElementAssembler assembler(mesh, dimension, 3, 1);
+
+    // Every element is assembled by exactly one rank:
+    const auto &owned_elements = assembler.OwnedElements();
+    for (Integer element_id = 0; element_id < mesh.GetNumElements(dimension); ++element_id) {
+        const auto owned = std::binary_search(owned_elements.begin(), owned_elements.end(), element_id);
+        EXPECT_EQ(assembler.OwnsElement(*mesh.GetElement(dimension, element_id)), owned);
+    }
+
+    auto num_owned = static_cast<Integer>(owned_elements.size());
+    Integer total_owned = 0;
+    MPI_Allreduce(&num_owned, &total_owned, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD);
+    EXPECT_EQ(total_owned, mesh.GetNumElements(dimension));
+}
+
 TEST(ProblemTypesTest, HeatEq2D) {
     HeatEq2D::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh2d.msh",
                              .thermal_conductivity = 1.0,
                              .dirichlet_bcs = {{"physical_curve_1", 100.0}},
-                             .neumann_bcs = {{"physical_curve_2", -100.0}}};
+                             .neumann_bcs = {{"physical_curve_2", -100.0}},
+                             .num_threads = 1,
+                             .mesh_cache = false,
+                             .node_ordering = NodeOrdering::Original,
+                             .matrix_free = false,
+                             .solver = SymmetricSolverOptions(),
+                             .transient = {}};
 
     HeatEq2D problem(input);
 
@@ -22,7 +294,13 @@ TEST(ProblemTypesTest, HeatEq2D_quadratic_mesh) {
     HeatEq2D::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh2d_quadratic.msh",
                              .thermal_conductivity = 1.0,
                              .dirichlet_bcs = {{"physical_curve_1", 100.0}},
-                             .neumann_bcs = {{"physical_curve_2", -100.0}}};
+                             .neumann_bcs = {{"physical_curve_2", -100.0}},
+                             .num_threads = 1,
+                             .mesh_cache = false,
+                             .node_ordering = NodeOrdering::Original,
+                             .matrix_free = false,
+                             .solver = SymmetricSolverOptions(),
+                             .transient = {}};
 
     HeatEq2D problem(input);
 
@@ -35,7 +313,13 @@ TEST(ProblemTypesTest, HeatEq3D) {
     HeatEq3D::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh3d.msh",
                              .thermal_conductivity = 1.0,
                              .dirichlet_bcs = {{"fixed", 100.0}, {"load", -100.0}},
-                             .neumann_bcs = {}};
+                             .neumann_bcs = {},
+                             .num_threads = 1,
+                             .mesh_cache = false,
+                             .node_ordering = NodeOrdering::Original,
+                             .matrix_free = false,
+                             .solver = SymmetricSolverOptions(),
+                             .transient = {}};
 
     HeatEq3D problem(input);
 
@@ -48,7 +332,13 @@ TEST(ProblemTypesTest, HeatEq3D_quadratic_mesh) {
     HeatEq3D::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh",
                              .thermal_conductivity = 1.0,
                              .dirichlet_bcs = {{"fixed", 100.0}, {"load", -100.0}},
-                             .neumann_bcs = {}};
+                             .neumann_bcs = {},
+                             .num_threads = 4,
+                             .mesh_cache = false,
+                             .node_ordering = NodeOrdering::Original,
+                             .matrix_free = false,
+                             .solver = SymmetricSolverOptions(),
+                             .transient = {}};
 
     HeatEq3D problem(input);
 
@@ -57,12 +347,208 @@ TEST(ProblemTypesTest, HeatEq3D_quadratic_mesh) {
     problem.WriteVTK("heat3d_quadratic.vtk");
 }
 
+// Compares two VTK files token by token, the numbers up to the solver's round-off:
+void ExpectSameVTK(const std::string &filename, const std::string &expected_filename) {
+    const auto read_tokens = [](const std::string &name) {
+        std::ifstream in(name);
+        return std::vector<std::string>(std::istream_iterator<std::string>(in), std::istream_iterator<std::string>());
+    };
+
+    const auto tokens = read_tokens(filename);
+    const auto expected = read_tokens(expected_filename);
+    ASSERT_EQ(tokens.size(), expected.size());
+
+    for (size_t ii = 0; ii < tokens.size(); ++ii) {
+        char *end = nullptr;
+        const auto value = std::strtod(expected[ii].c_str(), &end);
+        if (*end != '\0') {
+            EXPECT_EQ(tokens[ii], expected[ii]);
+            continue;
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+        EXPECT_NEAR(std::strtod(tokens[ii].c_str(), nullptr), value, 1.0e-6 * (1.0 + std::abs(value)));
+    }
+}
+
+TEST(ProblemTypesTest, HeatEq3D_reordered) {
+    const auto solve = [](NodeOrdering ordering, const std::string &output_filename) {
+        HeatEq3D::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh",
+                                 .thermal_conductivity = 1.0,
+                                 .dirichlet_bcs = {{"fixed", 100.0}, {"load", -100.0}},
+                                 .neumann_bcs = {},
+                                 .num_threads = 1,
+                                 .mesh_cache = false,
+                                 .node_ordering = ordering,
+                                 .matrix_free = false,
+                                 .solver = SymmetricSolverOptions(),
+                                 .transient = {}};
+
+        HeatEq3D problem(input);
+
+        problem.Solve();
+
+        problem.WriteVTK(output_filename);
+    };
+
+    solve(NodeOrdering::Original, "heat3d_original.vtk");
+
+    // The output is written in the original order, so only the solver's round-off differs:
+    for (const auto ordering : {NodeOrdering::ReverseCuthillMcKee, NodeOrdering::Hilbert}) {
+        solve(ordering, "heat3d_reordered.vtk");
+        ExpectSameVTK("heat3d_reordered.vtk", "heat3d_original.vtk");
+    }
+}
+
+TEST(ProblemTypesTest, HeatEq3D_transient) {
+    const auto solve = [](const TransientOptions &transient, const std::string &output_filename) {
+        HeatEq3D::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh3d.msh",
+                                 .thermal_conductivity = 1.0,
+                                 .dirichlet_bcs = {{"fixed", 100.0}, {"load", -100.0}},
+                                 .neumann_bcs = {},
+                                 .num_threads = 1,
+                                 .mesh_cache = false,
+                                 .node_ordering = NodeOrdering::Original,
+                                 .matrix_free = false,
+                                 .solver = SymmetricSolverOptions(),
+                                 .transient = transient};
+
+        HeatEq3D problem(input);
+
+        problem.Solve();
+
+        problem.WriteVTK(output_filename);
+    };
+
+    // Backward Euler with a time step far longer than the diffusion time reaches the steady state at once:
+    solve({}, "heat3d_steady.vtk");
+    solve({.method = TimeIntegration::BackwardEuler,
+           .heat_capacity = 1.0,
+           .initial_temperature = 0.0,
+           .time_step = 1.0e8, // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+           .num_time_steps = 2,
+           .output_interval = 1,
+           .output_filename = {}},
+          "heat3d_backward_euler.vtk");
+    ExpectSameVTK("heat3d_backward_euler.vtk", "heat3d_steady.vtk");
+
+    // Only every second and the last step are written while solving, and WriteVTK writes the last one:
+    const std::filesystem::path output_filename = "heat3d_crank_nicolson.vtk";
+    for (Integer step = 0; step <= 3; ++step) {
+        std::filesystem::remove(StepFilename(output_filename, step));
+    }
+
+    solve({.method = TimeIntegration::CrankNicolson,
+           .heat_capacity = 2.0,
+           .initial_temperature = 0.0,
+           .time_step = 0.01,
+           .num_time_steps = 3,
+           .output_interval = 2,
+           .output_filename = output_filename},
+          output_filename);
+    EXPECT_TRUE(std::filesystem::exists(StepFilename(output_filename, 0)));
+    EXPECT_FALSE(std::filesystem::exists(StepFilename(output_filename, 1)));
+    EXPECT_TRUE(std::filesystem::exists(StepFilename(output_filename, 2)));
+    ExpectSameVTK(StepFilename(output_filename, 3).string(), output_filename.string());
+}
+
+TEST(ProblemTypesTest, MatrixFree) {
+    Mesh mesh(GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh");
+
+    constexpr Integer dimension = 3;
+
+    Eigen::Matrix<Float, 6, 6> D = Eigen::Matrix<Float, 6, 6>::Identity();
+    D.topLeftCorner<3, 3>() += Eigen::Matrix<Float, 3, 3>::Constant(0.5);
+    constexpr Float conductivity = 2.0;
+
+    for (const auto dofs_per_node : {1, 3}) {
+        const ElementAssembler::ElementKernel kernel = [&](const Element &element, Eigen::MatrixXd &element_matrix) {
+            VisitElement<dimension>(element, [&](const auto &typed_element) {
+                if (dofs_per_node == 1) {
+                    element_matrix = ConductionStiffness(typed_element, conductivity);
+                } else {
+                    element_matrix = ElasticStiffness(typed_element, D);
+                }
+            });
+        };
+
+        ElementAssembler assembler(mesh, dimension, dofs_per_node, 1);
+        Matrix stiffness(assembler.Pattern());
+        assembler.AddElementMatrices(kernel, stiffness);
+        stiffness.Assemble();
+
+        Vector x(assembler.Pattern());
+        for (Integer ii = 0; ii < x.Size(); ++ii) {
+            if (assembler.Pattern().OwnsBlockRow(ii / dofs_per_node)) {
+                x.SetValue(ii, 1.0 + static_cast<Float>(ii % 11));
+            }
+        }
+        x.Assemble();
+
+        const auto expected = (stiffness * x).GatherAll();
+        const auto scale = std::abs(*std::max_element(expected.begin(), expected.end(), [](Float lhs, Float rhs) {
+            return std::abs(lhs) < std::abs(rhs);
+        }));
+
+        const Eigen::MatrixXd material = dofs_per_node == 1
+                                             ? Eigen::MatrixXd(conductivity * Eigen::MatrixXd::Identity(3, 3))
+                                             : Eigen::MatrixXd(D);
+        for (const auto num_threads : {1, 4}) {
+            MatrixFreeOperator matrix_free(mesh, dimension, dofs_per_node, material, num_threads);
+            auto matrix = matrix_free.CreateMatrix();
+            matrix.Assemble();
+
+            const auto actual = (matrix * x).GatherAll();
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t ii = 0; ii < actual.size(); ++ii) {
+                EXPECT_NEAR(actual[ii], expected[ii], 1.0e-12 * scale) << "dofs per node = " << dofs_per_node;
+            }
+
+            // With one rank all rows are owned and the diagonal is complete:
+            if (CommSize() == 1) {
+                std::vector<Float> diagonal(expected.size(), 0.0);
+                matrix_free.Diagonal(diagonal);
+                for (size_t ii = 0; ii < diagonal.size(); ++ii) {
+                    const auto row = static_cast<Integer>(ii);
+                    EXPECT_NEAR(diagonal[ii], stiffness.GetValue(row, row), 1.0e-12 * scale);
+                }
+            }
+        }
+    }
+}
+
+TEST(ProblemTypesTest, HeatEq3D_matrix_free) {
+    const auto solve = [](bool matrix_free, const std::string &output_filename) {
+        HeatEq3D::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh",
+                                 .thermal_conductivity = 1.0,
+                                 .dirichlet_bcs = {{"fixed", 100.0}, {"load", -100.0}},
+                                 .neumann_bcs = {},
+                                 .num_threads = 2,
+                                 .mesh_cache = false,
+                                 .node_ordering = NodeOrdering::Original,
+                                 .matrix_free = matrix_free,
+                                 .solver = SymmetricSolverOptions(),
+                                 .transient = {}};
+
+        HeatEq3D problem(input);
+
+        problem.Solve();
+
+        problem.WriteVTK(output_filename);
+    };
+
+    solve(false, "heat3d_assembled.vtk");
+    solve(true, "heat3d_matrix_free.vtk");
+    ExpectSameVTK("heat3d_matrix_free.vtk", "heat3d_assembled.vtk");
+}
+
 TEST(ProblemTypesTest, Mechanical) {
     Mechanical::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh",
                                .youngs_modulus = 69.0e9,
                                .poisson_ratio = 0.32,
                                .dirichlet_bcs = {{"fixed", {0.0, 0.0, 0.0}}},
-                               .neumann_bcs = {{"load", {0.0, -100.0, 0.0}}}};
+                               .neumann_bcs = {{"load", {0.0, -100.0, 0.0}}},
+                               .num_threads = 4};
 
     Mechanical problem(input);
 
@@ -71,6 +557,65 @@ TEST(ProblemTypesTest, Mechanical) {
     problem.WriteVTK("mechanical.vtk");
 }
 
+TEST(ProblemTypesTest, Mechanical_symmetric_storage) {
+    const auto solve = [](MatrixFormat format, const std::string &output_filename) {
+        // Pulling on one end exercises moving the prescribed displacements into the forcing:
+        Mechanical::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh",
+                                   .youngs_modulus = 69.0e9,
+                                   .poisson_ratio = 0.32,
+                                   .dirichlet_bcs = {{"fixed", {0.0, 0.0, 0.0}}, {"load", {0.0, -1.0e-3, 2.0e-3}}},
+                                   .matrix_format = format,
+                                   .num_threads = 2};
+        input.solver.method = KrylovMethod::PreOnly;
+        input.solver.preconditioner = Preconditioner::Cholesky;
+
+        Mechanical problem(input);
+        problem.Solve();
+        problem.WriteVTK(output_filename);
+    };
+
+    solve(MatrixFormat::AIJ, "mechanical_aij.vtk");
+    solve(MatrixFormat::SymmetricBlockAIJ, "mechanical_sbaij.vtk");
+    ExpectSameVTK("mechanical_sbaij.vtk", "mechanical_aij.vtk");
+}
+
+TEST(ProblemTypesTest, Mechanical_load_cases) {
+    Mechanical::Input input = {.mesh_filename = GetExecutablePath() / "assets/ProblemTypes/mesh3d_quadratic.msh",
+                               .youngs_modulus = 69.0e9,
+                               .poisson_ratio = 0.32,
+                               .dirichlet_bcs = {{"fixed", {0.0, 0.0, 0.0}}},
+                               .neumann_bcs = {},
+                               .matrix_format = MatrixFormat::BlockAIJ,
+                               .num_threads = 1,
+                               .mesh_cache = false,
+                               .node_ordering = NodeOrdering::Original,
+                               .matrix_free = false,
+                               .solver = SymmetricSolverOptions(),
+                               .load_cases = {}};
+
+    // Every load case is the same as solving it on its own:
+    const std::vector<Mechanical::LoadCase> load_cases = {
+        {.name = "down", .neumann_bcs = {{"load", {0.0, -100.0, 0.0}}}},
+        {.name = "side", .neumann_bcs = {{"load", {50.0, 0.0, 0.0}}}}};
+    for (const auto &load_case : load_cases) {
+        auto single_input = input;
+        single_input.neumann_bcs = load_case.neumann_bcs;
+
+        Mechanical problem(single_input);
+        problem.Solve();
+        problem.WriteVTK("mechanical_single_" + load_case.name + ".vtk");
+    }
+
+    input.load_cases = load_cases;
+    Mechanical problem(input);
+    problem.Solve();
+    problem.WriteVTK("mechanical_cases.vtk");
+
+    for (const auto &load_case : load_cases) {
+        ExpectSameVTK("mechanical_cases_" + load_case.name + ".vtk", "mechanical_single_" + load_case.name + ".vtk");
+    }
+}
+
 } // namespace plasmatic
 
 int main(int argc, char **argv) {
@@ -0,0 +1,31 @@
+#include "interface/Utility/Checksum.h"
+
+#include <cstring>
+
+namespace plasmatic {
+
+uint64_t Checksum(std::string_view data) {
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    constexpr uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+
+    // Mixes in 8 bytes at a time, which is much faster than hashing byte by byte on large files:
+    uint64_t hash = 0xCBF29CE484222325ULL ^ data.size();
+    size_t ii = 0;
+    for (; ii + sizeof(uint64_t) <= data.size(); ii += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        std::memcpy(&word, &data[ii], sizeof(uint64_t));
+
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+    }
+
+    for (; ii < data.size(); ++ii) {
+        hash = (hash ^ static_cast<unsigned char>(data[ii])) * multiplier;
+        hash ^= hash >> 32;
+    }
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+    return hash;
+}
+
+} // namespace plasmatic
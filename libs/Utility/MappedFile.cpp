@@ -0,0 +1,60 @@
+#include "interface/Utility/MappedFile.h"
+#include "interface/Utility/Check.h"
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace plasmatic {
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+MappedFile::MappedFile(const std::filesystem::path &filename) {
+#if defined(_WIN32)
+    std::ifstream in(filename, std::ios::binary);
+    Check(in.good(), "Could not open file '{}'", filename.string());
+
+    _buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    _data = _buffer.data();
+    _size = _buffer.size();
+
+#else
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    auto fd = open(filename.c_str(), O_RDONLY);
+    Check(fd != -1, "Could not open file '{}'", filename.string());
+
+    struct stat file_stat = {};
+    auto status = fstat(fd, &file_stat);
+    Check(status == 0, "Could not get the size of file '{}'", filename.string());
+
+    _size = static_cast<size_t>(file_stat.st_size);
+
+    // Mapping an empty file fails, but there is nothing to map then anyway:
+    if (_size > 0) {
+        _mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast,performance-no-int-to-ptr)
+        Check(_mapping != MAP_FAILED, "Could not memory map file '{}'", filename.string());
+
+        // The file is mostly read front to back, so let the kernel read ahead aggressively:
+        madvise(_mapping, _size, MADV_SEQUENTIAL);
+
+        _data = static_cast<const char *>(_mapping);
+    }
+
+    close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if !defined(_WIN32)
+    if (_mapping != nullptr) {
+        munmap(_mapping, _size);
+    }
+#endif
+}
+
+} // namespace plasmatic
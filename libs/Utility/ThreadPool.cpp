@@ -0,0 +1,95 @@
+#include "interface/Utility/ThreadPool.h"
+#include "interface/Utility/Check.h"
+
+#include <algorithm>
+
+namespace plasmatic {
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+ThreadPool::ThreadPool(Integer num_threads) {
+    Check(num_threads >= 1, "A thread pool needs at least one thread, got {}", num_threads);
+
+    _workers.reserve(static_cast<size_t>(num_threads - 1));
+    for (Integer ii = 1; ii < num_threads; ++ii) {
+        _workers.emplace_back([this, ii]() { WorkerLoop(ii); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _startCondition.notify_all();
+
+    for (auto &worker : _workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(Integer begin, Integer end, Integer chunk_size, const RangeFunction &fn) {
+    Check(chunk_size >= 1, "Chunk size must be positive, got {}", chunk_size);
+
+    if (begin >= end) {
+        return;
+    }
+
+    if (_workers.empty()) {
+        fn(begin, end, 0);
+        return;
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _fn = &fn;
+        _end = end;
+        _chunkSize = chunk_size;
+        _next = begin;
+        _numBusy = static_cast<Integer>(_workers.size());
+        ++_generation;
+    }
+    _startCondition.notify_all();
+
+    RunChunks(0);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCondition.wait(lock, [this]() { return _numBusy == 0; });
+    _fn = nullptr;
+}
+
+Integer ThreadPool::HardwareThreads() { return std::max(static_cast<Integer>(std::thread::hardware_concurrency()), 1); }
+
+void ThreadPool::WorkerLoop(Integer thread_index) {
+    Integer generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _startCondition.wait(lock, [this, generation]() { return _stop || _generation != generation; });
+            if (_stop) {
+                return;
+            }
+            generation = _generation;
+        }
+
+        RunChunks(thread_index);
+
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            --_numBusy;
+        }
+        _doneCondition.notify_one();
+    }
+}
+
+void ThreadPool::RunChunks(Integer thread_index) {
+    while (true) {
+        const auto chunk_begin = _next.fetch_add(_chunkSize);
+        if (chunk_begin >= _end) {
+            return;
+        }
+
+        (*_fn)(chunk_begin, std::min(chunk_begin + _chunkSize, _end), thread_index);
+    }
+}
+
+} // namespace plasmatic
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace plasmatic {
+
+// Fast 64 bit (non cryptographic) hash of some data, e.g. to tell whether a file changed since it was last read:
+uint64_t Checksum(std::string_view data);
+
+} // namespace plasmatic
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace plasmatic {
+
+// Read-only view of the whole contents of a file. The file is memory mapped where the platform allows it (so pages
+// are only read from disk as they are touched) and read into memory otherwise.
+class MappedFile {
+  public:
+    MappedFile(const std::filesystem::path &filename);
+
+    MappedFile(const MappedFile &other) = delete;
+
+    MappedFile &operator=(const MappedFile &other) = delete;
+
+    ~MappedFile();
+
+    std::string_view Contents() const { return {_data, _size}; }
+
+    size_t Size() const { return _size; }
+
+  private:
+    const char *_data = nullptr;
+    size_t _size = 0;
+
+    void *_mapping = nullptr;
+    std::vector<char> _buffer;
+};
+
+} // namespace plasmatic
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace plasmatic {
+
+// Fixed set of worker threads that are kept alive between parallel loops, so that a loop only costs a wake up rather
+// than a thread creation. The calling thread takes part in every loop as thread 0.
+class ThreadPool {
+  public:
+    using RangeFunction = std::function<void(Integer begin, Integer end, Integer thread_index)>;
+
+    ThreadPool(Integer num_threads);
+
+    ThreadPool(const ThreadPool &other) = delete;
+
+    ThreadPool &operator=(const ThreadPool &other) = delete;
+
+    ~ThreadPool();
+
+    Integer NumThreads() const { return static_cast<Integer>(_workers.size()) + 1; }
+
+    // Splits [begin, end) into chunks of at most `chunk_size` that are handed out to the threads as they become free
+    // and calls fn(chunk_begin, chunk_end, thread_index) on each of them. Returns once every chunk is done.
+    void ParallelFor(Integer begin, Integer end, Integer chunk_size, const RangeFunction &fn);
+
+    // Number of hardware threads (at least 1):
+    static Integer HardwareThreads();
+
+  private:
+    void WorkerLoop(Integer thread_index);
+
+    void RunChunks(Integer thread_index);
+
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _startCondition;
+    std::condition_variable _doneCondition;
+
+    const RangeFunction *_fn = nullptr;
+    Integer _end = 0;
+    Integer _chunkSize = 1;
+    std::atomic<Integer> _next = 0;
+
+    Integer _generation = 0;
+    Integer _numBusy = 0;
+    bool _stop = false;
+};
+
+} // namespace plasmatic
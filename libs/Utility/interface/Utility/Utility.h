@@ -2,6 +2,9 @@
 
 #include "Abort.h"
 #include "Check.h"
+#include "Checksum.h"
 #include "ExecutablePath.h"
 #include "Log.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
 #include "Types.h"
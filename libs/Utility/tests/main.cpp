@@ -2,11 +2,86 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <numeric>
+
 namespace plasmatic {
 TEST(UtilityTest, Types) {
     EXPECT_EQ(sizeof(Float), 8);
     EXPECT_EQ(sizeof(Integer), 4);
 }
+
+TEST(UtilityTest, ThreadPool) {
+    constexpr Integer num_threads = 4;
+    constexpr Integer size = 10007;
+
+    ThreadPool pool(num_threads);
+    EXPECT_EQ(pool.NumThreads(), num_threads);
+
+    // Every index must be visited exactly once, and the pool must be reusable for many loops:
+    std::vector<Integer> visits(size, 0);
+    std::vector<Integer> thread_counts(num_threads, 0);
+    for (Integer loop = 0; loop < 100; ++loop) {
+        pool.ParallelFor(0, size, 64, [&visits, &thread_counts](Integer begin, Integer end, Integer thread_index) {
+            for (Integer ii = begin; ii < end; ++ii) {
+                visits[static_cast<size_t>(ii)]++;
+            }
+            thread_counts[static_cast<size_t>(thread_index)] += end - begin;
+        });
+    }
+
+    for (const auto &visit : visits) {
+        EXPECT_EQ(visit, 100);
+    }
+    EXPECT_EQ(std::accumulate(thread_counts.begin(), thread_counts.end(), 0), 100 * size);
+
+    // Empty ranges and a single thread pool are fine too:
+    pool.ParallelFor(5, 5, 1, [](Integer, Integer, Integer) { ADD_FAILURE(); });
+
+    ThreadPool serial_pool(1);
+    Integer sum = 0;
+    serial_pool.ParallelFor(0, 10, 3, [&sum](Integer begin, Integer end, Integer thread_index) {
+        EXPECT_EQ(thread_index, 0);
+        for (Integer ii = begin; ii < end; ++ii) {
+            sum += ii;
+        }
+    });
+    EXPECT_EQ(sum, 45);
+}
+
+TEST(UtilityTest, Checksum) {
+    const std::string data = "$Nodes\n1 11 1 11\n2 1 0 1\n";
+
+    EXPECT_EQ(Checksum(data), Checksum(std::string(data)));
+    EXPECT_NE(Checksum(data), Checksum(data.substr(0, data.size() - 1)));
+
+    // A single changed byte (in the word aligned part or in the tail) changes the checksum:
+    for (const auto position : {size_t{3}, data.size() - 1}) {
+        auto changed = data;
+        changed[position] = 'x';
+        EXPECT_NE(Checksum(data), Checksum(changed)) << "position = " << position;
+    }
+}
+
+TEST(UtilityTest, MappedFile) {
+    const std::string contents = "$Nodes\n1 2 3\n$EndNodes\n";
+    {
+        std::ofstream out("mapped_file.txt", std::ios::binary);
+        out << contents;
+    }
+
+    MappedFile file("mapped_file.txt");
+    EXPECT_EQ(file.Size(), contents.size());
+    EXPECT_EQ(file.Contents(), contents);
+
+    {
+        std::ofstream out("mapped_file_empty.txt");
+    }
+
+    MappedFile empty_file("mapped_file_empty.txt");
+    EXPECT_EQ(empty_file.Size(), 0);
+    EXPECT_TRUE(empty_file.Contents().empty());
+}
 } // namespace plasmatic
 
 int main(int argc, char **argv) {